@@ -30,6 +30,42 @@ static struct {
     int unfixable_houses;
 } extra = {0, 0, 0, 0};
 
+// buildings that may be houses: loops over houses skip the others without touching them
+static uint8_t house_slots[MAX_BUILDINGS];
+
+static int may_be_house(const building *b)
+{
+    return b->state != BUILDING_STATE_UNUSED && (b->house_size || building_is_house(b->type));
+}
+
+// buildings that may be burning ruins, so the daily fire pass can skip the others
+static struct {
+    uint8_t slots[MAX_BUILDINGS];
+    int count;
+} ruins;
+
+static int may_be_burning_ruin(const building *b)
+{
+    return (b->state == BUILDING_STATE_CREATED || b->state == BUILDING_STATE_IN_USE) &&
+        b->type == BUILDING_BURNING_RUIN;
+}
+
+static void set_ruin_slot(int building_id, int may_be_ruin)
+{
+    if (ruins.slots[building_id] != may_be_ruin) {
+        ruins.slots[building_id] = may_be_ruin;
+        ruins.count += may_be_ruin ? 1 : -1;
+    }
+}
+
+static void update_house_slots(void)
+{
+    for (int i = 0; i < MAX_BUILDINGS; i++) {
+        house_slots[i] = may_be_house(&all_buildings[i]);
+        set_ruin_slot(i, may_be_burning_ruin(&all_buildings[i]));
+    }
+}
+
 building *building_get(int id)
 {
     return &all_buildings[id];
@@ -90,6 +126,9 @@ building *building_create(building_type type, int x, int y)
         b->house_size = 4;
     }
 
+    house_slots[b->id] = may_be_house(b);
+    set_ruin_slot(b->id, type == BUILDING_BURNING_RUIN);
+
     // subtype
     if (building_is_house(type)) {
         b->subtype.house_level = type - BUILDING_HOUSE_VACANT_LOT;
@@ -290,6 +329,31 @@ int building_get_highest_id(void)
     return extra.highest_id_in_use;
 }
 
+int building_may_be_house(int building_id)
+{
+    return house_slots[building_id];
+}
+
+void building_update_house_index(building *b)
+{
+    house_slots[b->id] = may_be_house(b);
+}
+
+int building_may_be_burning_ruin(int building_id)
+{
+    return ruins.slots[building_id];
+}
+
+int building_has_burning_ruin_slots(void)
+{
+    return ruins.count > 0;
+}
+
+void building_update_ruin_index(building *b)
+{
+    set_ruin_slot(b->id, may_be_burning_ruin(b));
+}
+
 void building_update_highest_id(void)
 {
     extra.highest_id_in_use = 0;
@@ -297,6 +361,8 @@ void building_update_highest_id(void)
         if (all_buildings[i].state != BUILDING_STATE_UNUSED) {
             extra.highest_id_in_use = i;
         }
+        house_slots[i] = may_be_house(&all_buildings[i]);
+        set_ruin_slot(i, may_be_burning_ruin(&all_buildings[i]));
     }
     if (extra.highest_id_in_use > extra.highest_id_ever) {
         extra.highest_id_ever = extra.highest_id_in_use;
@@ -322,6 +388,7 @@ void building_clear_all(void)
     extra.created_sequence = 0;
     extra.incorrect_houses = 0;
     extra.unfixable_houses = 0;
+    update_house_slots();
 }
 
 void building_save_state(buffer *buf, buffer *highest_id, buffer *highest_id_ever,
@@ -353,4 +420,5 @@ void building_load_state(buffer *buf, buffer *highest_id, buffer *highest_id_eve
 
     extra.incorrect_houses = buffer_read_i32(corrupt_houses);
     extra.unfixable_houses = buffer_read_i32(corrupt_houses);
+    update_house_slots();
 }
@@ -157,6 +157,40 @@ int building_is_house(building_type type);
 
 int building_is_fort(building_type type);
 
+/**
+ * Checks whether a building may be a house, without reading the building itself.
+ * Loops over all houses use this to skip other buildings quickly; the building
+ * still has to be checked for being a house in use.
+ * @param building_id Building id
+ * @return 0 if the building is certainly not a house
+ */
+int building_may_be_house(int building_id);
+
+/**
+ * Updates the house index for a building whose data was overwritten, e.g. by undo
+ * @param b Building
+ */
+void building_update_house_index(building *b);
+
+/**
+ * Checks whether a building may be a burning ruin, without reading the building itself
+ * @param building_id Building id
+ * @return 0 if the building is certainly not a burning ruin
+ */
+int building_may_be_burning_ruin(int building_id);
+
+/**
+ * Checks whether any building may be a burning ruin
+ * @return 0 if there are certainly no burning ruins
+ */
+int building_has_burning_ruin_slots(void);
+
+/**
+ * Updates the burning ruin index for a building that changed type or state
+ * @param b Building
+ */
+void building_update_ruin_index(building *b);
+
 int building_get_highest_id(void);
 
 void building_update_highest_id(void);
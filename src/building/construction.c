@@ -66,6 +66,12 @@ static struct {
     int draw_as_constructing;
     int start_offset_x_view;
     int start_offset_y_view;
+    struct {
+        int valid;
+        building_type type;
+        int orientation;
+        int map_changes;
+    } preview;
 } data;
 
 static int last_items_cleared;
@@ -77,6 +83,39 @@ static void mark_construction(int x, int y, int size, int terrain, int absolute_
     }
 }
 
+static void reset_preview(void)
+{
+    data.preview.valid = 0;
+    map_routing_cache_building_distances(0);
+}
+
+static int is_preview_map_unchanged(building_type type)
+{
+    // only the previous preview changed the map, and the undo restore reverts that
+    return data.in_progress && data.preview.valid && data.preview.type == type &&
+        data.preview.orientation == city_view_orientation() &&
+        data.preview.map_changes == map_grid_journal_changes();
+}
+
+static void store_preview(building_type type)
+{
+    data.preview.valid = data.in_progress;
+    data.preview.type = type;
+    data.preview.orientation = city_view_orientation();
+    data.preview.map_changes = map_grid_journal_changes();
+}
+
+static void update_aqueduct_images(int include_construction, int map_unchanged)
+{
+    int x_min, y_min, x_max, y_max;
+    if (!map_unchanged) {
+        map_tiles_update_all_aqueducts(include_construction);
+    } else if (game_undo_get_changed_area(&x_min, &y_min, &x_max, &y_max)) {
+        // tiles outside the changed area still have the images of the last full update
+        map_tiles_update_region_aqueducts(x_min - 3, y_min - 3, x_max + 3, y_max + 3, include_construction);
+    }
+}
+
 static int place_houses(int measure_only, int x_start, int y_start, int x_end, int y_end)
 {
     int x_min, x_max, y_min, y_max;
@@ -278,6 +317,7 @@ void building_construction_set_type(building_type type)
     data.end.x = 0;
     data.end.y = 0;
     data.cost_preview = 0;
+    reset_preview();
 
     if (type != BUILDING_NONE) {
         data.required_terrain.wall = 0;
@@ -376,6 +416,7 @@ void building_construction_start(int x, int y, int grid_offset)
     data.start.grid_offset = grid_offset;
     data.start.x = data.end.x = x;
     data.start.y = data.end.y = y;
+    reset_preview();
 
     if (game_undo_start_build(data.type)) {
         data.in_progress = 1;
@@ -422,6 +463,7 @@ int building_construction_is_updatable(void)
 
 void building_construction_cancel(void)
 {
+    reset_preview();
     map_property_clear_constructing_and_deleted();
     if (data.in_progress && building_construction_is_updatable()) {
         game_undo_restore_building_state();
@@ -449,6 +491,11 @@ void building_construction_update(int x, int y, int grid_offset)
         data.cost_preview = 0;
         return;
     }
+    int map_unchanged = is_preview_map_unchanged(type);
+    if (!map_unchanged) {
+        map_routing_cache_building_distances(0);
+    }
+    map_routing_cache_building_distances(data.in_progress);
     map_property_clear_constructing_and_deleted();
     int current_cost = model_get_building(type)->cost;
 
@@ -472,12 +519,12 @@ void building_construction_update(int x, int y, int grid_offset)
         if (length > 1) current_cost *= length;
     } else if (type == BUILDING_AQUEDUCT) {
         building_construction_place_aqueduct(data.start.x, data.start.y, x, y, &current_cost);
-        map_tiles_update_all_aqueducts(0);
+        update_aqueduct_images(0, map_unchanged);
     } else if (type == BUILDING_DRAGGABLE_RESERVOIR) {
         struct reservoir_info info;
         place_reservoir_and_aqueducts(1, data.start.x, data.start.y, x, y, &info);
         current_cost = info.cost;
-        map_tiles_update_all_aqueducts(1);
+        update_aqueduct_images(1, map_unchanged);
         data.draw_as_constructing = 0;
     } else if (type == BUILDING_HOUSE_VACANT_LOT) {
         int items_placed = place_houses(1, data.start.x, data.start.y, x, y);
@@ -530,6 +577,7 @@ void building_construction_update(int x, int y, int grid_offset)
         }
     }
     data.cost_preview = current_cost;
+    store_preview(type);
 }
 
 static int has_nearby_enemy(int x_start, int y_start, int x_end, int y_end)
@@ -557,6 +605,7 @@ void building_construction_place(void)
 {
     data.cost_preview = 0;
     data.in_progress = 0;
+    reset_preview();
     int x_start = data.start.x;
     int y_start = data.start.y;
     int x_end = data.end.x;
@@ -155,7 +155,7 @@ static int clear_land_confirmed(int measure_only, int x_start, int y_start, int
         map_tiles_update_area_roads(x_min, y_min, radius);
         map_tiles_update_all_plazas();
         map_tiles_update_area_walls(x_min, y_min, radius);
-        map_tiles_update_region_aqueducts(x_min - 3, y_min - 3, x_max + 3, y_max + 3);
+        map_tiles_update_region_aqueducts(x_min - 3, y_min - 3, x_max + 3, y_max + 3, 0);
     }
     if (!measure_only) {
         map_routing_update_land();
@@ -48,6 +48,7 @@ static void destroy_on_fire(building *b, int plagued)
         b->state = BUILDING_STATE_DELETED_BY_GAME;
     } else {
         b->type = BUILDING_BURNING_RUIN;
+        building_update_ruin_index(b);
         b->figure_id4 = 0;
         b->tax_income_or_storage = 0;
         b->fire_duration = (b->house_figure_generation_delay & 7) + 1;
@@ -223,7 +224,7 @@ void building_destroy_by_enemy(int x, int y, int grid_offset)
     }
     figure_tower_sentry_reroute();
     map_tiles_update_area_walls(x, y, 3);
-    map_tiles_update_region_aqueducts(x - 3, y - 3, x + 3, y + 3);
+    map_tiles_update_region_aqueducts(x - 3, y - 3, x + 3, y + 3, 0);
     map_routing_update_land();
     map_routing_update_walls();
 }
@@ -509,6 +509,9 @@ void building_house_process_evolve_and_consume_goods(void)
     house_demands *demands = city_houses_demands();
     int has_expanded = 0;
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE && building_is_house(b->type)) {
             building_house_check_for_corruption(b);
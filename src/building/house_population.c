@@ -9,6 +9,16 @@
 #include "city/population.h"
 #include "core/calc.h"
 #include "figuretype/migrant.h"
+#include "map/grid.h"
+
+#define ROOM_INDEX_CELL_SIZE 8
+#define ROOM_INDEX_CELLS ((GRID_SIZE + ROOM_INDEX_CELL_SIZE - 1) / ROOM_INDEX_CELL_SIZE)
+
+static struct {
+    int valid;
+    int cell_start[ROOM_INDEX_CELLS * ROOM_INDEX_CELLS + 1];
+    int houses[MAX_BUILDINGS];
+} room_index;
 
 int house_population_add_to_city(int num_people)
 {
@@ -18,6 +28,9 @@ int house_population_add_to_city(int num_people)
         if (++building_id >= MAX_BUILDINGS) {
             building_id = 1;
         }
+        if (!building_may_be_house(building_id)) {
+            continue;
+        }
         building *b = building_get(building_id);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size
             && b->distance_from_entry > 0 && b->house_population > 0) {
@@ -44,6 +57,9 @@ int house_population_remove_from_city(int num_people)
         if (++building_id >= MAX_BUILDINGS) {
             building_id = 1;
         }
+        if (!building_may_be_house(building_id)) {
+            continue;
+        }
         building *b = building_get(building_id);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             city_population_set_last_used_house_remove(building_id);
@@ -60,6 +76,9 @@ static void fill_building_list_with_houses(void)
 {
     building_list_large_clear(0);
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             building_list_large_add(i);
@@ -135,6 +154,98 @@ int house_population_create_immigrants(int num_people)
     return num_people - to_immigrate;
 }
 
+void house_population_clear_room_index(void)
+{
+    room_index.valid = 0;
+}
+
+static int room_index_cell(int x, int y)
+{
+    return (y / ROOM_INDEX_CELL_SIZE) * ROOM_INDEX_CELLS + x / ROOM_INDEX_CELL_SIZE;
+}
+
+static void build_room_index(void)
+{
+    // counting sort of all houses by cell; room and immigrants are checked when searching
+    int *cell_start = room_index.cell_start;
+    for (int i = 0; i <= ROOM_INDEX_CELLS * ROOM_INDEX_CELLS; i++) {
+        cell_start[i] = 0;
+    }
+    int max_id = building_get_highest_id();
+    for (int i = 1; i <= max_id; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
+        building *b = building_get(i);
+        if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
+            cell_start[room_index_cell(b->x, b->y) + 1]++;
+        }
+    }
+    for (int i = 0; i < ROOM_INDEX_CELLS * ROOM_INDEX_CELLS; i++) {
+        cell_start[i + 1] += cell_start[i];
+    }
+    for (int i = 1; i <= max_id; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
+        building *b = building_get(i);
+        if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
+            room_index.houses[cell_start[room_index_cell(b->x, b->y)]++] = i;
+        }
+    }
+    for (int i = ROOM_INDEX_CELLS * ROOM_INDEX_CELLS; i > 0; i--) {
+        cell_start[i] = cell_start[i - 1];
+    }
+    cell_start[0] = 0;
+    room_index.valid = 1;
+}
+
+static int has_room_for_homeless(const building *b)
+{
+    return b->state == BUILDING_STATE_IN_USE && b->house_size && b->distance_from_entry > 0 &&
+        b->house_population_room > 0 && !b->immigrant_figure_id;
+}
+
+int house_population_closest_house_with_room(int x, int y)
+{
+    if (!room_index.valid) {
+        build_room_index();
+    }
+    int min_dist = 1000;
+    int min_building_id = 0;
+    int cell_x = x / ROOM_INDEX_CELL_SIZE;
+    int cell_y = y / ROOM_INDEX_CELL_SIZE;
+    for (int ring = 0; ring < ROOM_INDEX_CELLS; ring++) {
+        // houses in this ring are at least this far away, equal distances are decided by id
+        if (ring > 0 && (ring - 1) * ROOM_INDEX_CELL_SIZE + 1 > min_dist) {
+            break;
+        }
+        for (int cy = cell_y - ring; cy <= cell_y + ring; cy++) {
+            if (cy < 0 || cy >= ROOM_INDEX_CELLS) {
+                continue;
+            }
+            int on_edge_row = cy == cell_y - ring || cy == cell_y + ring;
+            for (int cx = cell_x - ring; cx <= cell_x + ring; cx += on_edge_row ? 1 : 2 * ring) {
+                if (cx >= 0 && cx < ROOM_INDEX_CELLS) {
+                    int cell = cy * ROOM_INDEX_CELLS + cx;
+                    for (int i = room_index.cell_start[cell]; i < room_index.cell_start[cell + 1]; i++) {
+                        int building_id = room_index.houses[i];
+                        building *b = building_get(building_id);
+                        if (has_room_for_homeless(b)) {
+                            int dist = calc_maximum_distance(x, y, b->x, b->y);
+                            if (dist < min_dist || (dist == min_dist && building_id < min_building_id)) {
+                                min_dist = dist;
+                                min_building_id = building_id;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return min_building_id;
+}
+
 int house_population_create_emigrants(int num_people)
 {
     int total_houses = building_list_large_size();
@@ -44,4 +44,18 @@ int house_population_create_immigrants(int num_people);
  */
 int house_population_create_emigrants(int num_people);
 
+/**
+ * Marks the spatial index of houses as outdated, so it is rebuilt on the next search.
+ * Must be called before houses may have been added, removed or moved since the last search.
+ */
+void house_population_clear_room_index(void);
+
+/**
+ * Finds the closest house that has room for homeless people and is not waiting for an immigrant
+ * @param x X coordinate to search from
+ * @param y Y coordinate to search from
+ * @return Building id of the house, or 0 if none has room. Ties are broken by lowest id.
+ */
+int house_population_closest_house_with_room(int x, int y);
+
 #endif // BUILDING_HOUSE_POPULATION_H
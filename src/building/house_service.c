@@ -15,6 +15,9 @@ static void decay(unsigned char *value)
 void house_service_decay_culture(void)
 {
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
             continue;
@@ -68,6 +71,9 @@ void house_service_calculate_culture_aggregates(void)
 {
     int base_entertainment = city_culture_coverage_average_entertainment() / 5;
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
             continue;
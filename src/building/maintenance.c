@@ -39,9 +39,16 @@ void building_maintenance_update_burning_ruins(void)
     scenario_climate climate = scenario_property_climate();
     int recalculate_terrain = 0;
     building_list_burning_clear();
+    if (!building_has_burning_ruin_slots()) {
+        return;
+    }
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_burning_ruin(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state != BUILDING_STATE_IN_USE || b->type != BUILDING_BURNING_RUIN) {
+            building_update_ruin_index(b);
             continue;
         }
         if (b->fire_duration < 0) {
@@ -51,6 +58,7 @@ void building_maintenance_update_burning_ruins(void)
         if (b->fire_duration > 32) {
             game_undo_disable();
             b->state = BUILDING_STATE_RUBBLE;
+            building_update_ruin_index(b);
             map_building_tiles_set_rubble(i, b->x, b->y, b->size);
             recalculate_terrain = 1;
             continue;
@@ -167,6 +167,9 @@ void city_culture_calculate(void)
 
     int num_houses = 0;
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             num_houses++;
@@ -73,17 +73,11 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.population.academy_age);
     buffer_write_i32(main, city_data.population.total_capacity);
     buffer_write_i32(main, city_data.population.room_in_houses);
-    for (int i = 0; i < 2400; i++) {
-        buffer_write_i32(main, city_data.population.monthly.values[i]);
-    }
+    buffer_write_i32_array(main, city_data.population.monthly.values, 2400);
     buffer_write_i32(main, city_data.population.monthly.next_index);
     buffer_write_i32(main, city_data.population.monthly.count);
-    for (int i = 0; i < 100; i++) {
-        buffer_write_i16(main, city_data.population.at_age[i]);
-    }
-    for (int i = 0; i < 20; i++) {
-        buffer_write_i32(main, city_data.population.at_level[i]);
-    }
+    buffer_write_i16_array(main, city_data.population.at_age, 100);
+    buffer_write_i32_array(main, city_data.population.at_level, 20);
     buffer_write_i32(main, city_data.population.yearly_births);
     buffer_write_i32(main, city_data.population.yearly_deaths);
     buffer_write_i32(main, city_data.population.lost_removal);
@@ -109,14 +103,10 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.migration.immigration_duration);
     buffer_write_i32(main, city_data.migration.emigration_duration);
     buffer_write_i32(main, city_data.migration.newcomers);
-    for (int i = 0; i < 4; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_27e0[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_27e0, 4);
     buffer_write_i16(main, city_data.unused.unknown_27f0);
     buffer_write_i16(main, city_data.resource.last_used_warehouse);
-    for (int i = 0; i < 18; i++) {
-        buffer_write_i16(main, city_data.unused.unknown_27f4[i]);
-    }
+    buffer_write_i16_array(main, city_data.unused.unknown_27f4, 18);
     buffer_write_u8(main, city_data.map.entry_point.x);
     buffer_write_u8(main, city_data.map.entry_point.y);
     buffer_write_i16(main, city_data.map.entry_point.grid_offset);
@@ -128,40 +118,22 @@ static void save_main_data(buffer *main)
     buffer_write_i16(main, city_data.building.senate_grid_offset);
     buffer_write_i32(main, city_data.building.senate_building_id);
     buffer_write_i16(main, city_data.unused.unknown_2828);
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        buffer_write_i16(main, city_data.resource.space_in_warehouses[i]);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        buffer_write_i16(main, city_data.resource.stored_in_warehouses[i]);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        buffer_write_i16(main, city_data.resource.trade_status[i]);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        buffer_write_i16(main, city_data.resource.export_over[i]);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        buffer_write_i16(main, city_data.resource.mothballed[i]);
-    }
+    buffer_write_i16_array(main, city_data.resource.space_in_warehouses, RESOURCE_MAX);
+    buffer_write_i16_array(main, city_data.resource.stored_in_warehouses, RESOURCE_MAX);
+    buffer_write_i16_array(main, city_data.resource.trade_status, RESOURCE_MAX);
+    buffer_write_i16_array(main, city_data.resource.export_over, RESOURCE_MAX);
+    buffer_write_i16_array(main, city_data.resource.mothballed, RESOURCE_MAX);
     buffer_write_i16(main, city_data.unused.unused_28ca);
-    for (int i = 0; i < RESOURCE_MAX_FOOD; i++) {
-        buffer_write_i32(main, city_data.resource.granary_food_stored[i]);
-    }
-    for (int i = 0; i < 6; i++) {
-        buffer_write_i32(main, city_data.resource.stored_in_workshops[i]);
-    }
-    for (int i = 0; i < 6; i++) {
-        buffer_write_i32(main, city_data.resource.space_in_workshops[i]);
-    }
+    buffer_write_i32_array(main, city_data.resource.granary_food_stored, RESOURCE_MAX_FOOD);
+    buffer_write_i32_array(main, city_data.resource.stored_in_workshops, 6);
+    buffer_write_i32_array(main, city_data.resource.space_in_workshops, 6);
     buffer_write_i32(main, city_data.resource.granary_total_stored);
     buffer_write_i32(main, city_data.resource.food_types_available);
     buffer_write_i32(main, city_data.resource.food_types_eaten);
     for (int i = 0; i < 272; i++) {
         buffer_write_i8(main, city_data.unused.unknown_2924[i]);
     }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        buffer_write_i32(main, city_data.resource.stockpiled[i]);
-    }
+    buffer_write_i32_array(main, city_data.resource.stockpiled, RESOURCE_MAX);
     buffer_write_i32(main, city_data.resource.food_supply_months);
     buffer_write_i32(main, city_data.resource.granaries.operating);
     buffer_write_i32(main, city_data.population.percentage_plebs);
@@ -226,21 +198,15 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.finance.this_year.net_in_out);
     buffer_write_i32(main, city_data.finance.last_year.balance);
     buffer_write_i32(main, city_data.finance.this_year.balance);
-    for (int i = 0; i < 1400; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_2c20[i]);
-    }
-    for (int i = 0; i < 8; i++) {
-        buffer_write_i32(main, city_data.unused.houses_requiring_unknown_to_evolve[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_2c20, 1400);
+    buffer_write_i32_array(main, city_data.unused.houses_requiring_unknown_to_evolve, 8);
     buffer_write_i32(main, city_data.trade.caravan_import_resource);
     buffer_write_i32(main, city_data.trade.caravan_backup_import_resource);
     buffer_write_i32(main, city_data.ratings.culture);
     buffer_write_i32(main, city_data.ratings.prosperity);
     buffer_write_i32(main, city_data.ratings.peace);
     buffer_write_i32(main, city_data.ratings.favor);
-    for (int i = 0; i < 4; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_4238[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_4238, 4);
     buffer_write_i32(main, city_data.ratings.prosperity_treasury_last_year);
     buffer_write_i32(main, city_data.ratings.culture_points.theater);
     buffer_write_i32(main, city_data.ratings.culture_points.religion);
@@ -260,9 +226,7 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.houses.missing.barber);
     buffer_write_i32(main, city_data.houses.missing.bathhouse);
     buffer_write_i32(main, city_data.houses.missing.food);
-    for (int i = 0; i < 2; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_4294[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_4294, 2);
     buffer_write_i32(main, city_data.building.hippodrome_placed);
     buffer_write_i32(main, city_data.houses.missing.clinic);
     buffer_write_i32(main, city_data.houses.missing.hospital);
@@ -329,18 +293,12 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.ratings.favor_explanation);
     buffer_write_i32(main, city_data.emperor.player_rank);
     buffer_write_i32(main, city_data.emperor.personal_savings);
-    for (int i = 0; i < 2; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_4374[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_4374, 2);
     buffer_write_i32(main, city_data.finance.last_year.income.donated);
     buffer_write_i32(main, city_data.finance.this_year.income.donated);
     buffer_write_i32(main, city_data.emperor.donate_amount);
-    for (int i = 0; i < 10; i++) {
-        buffer_write_i16(main, city_data.building.working_dock_ids[i]);
-    }
-    for (int i = 0; i < 3; i++) {
-        buffer_write_i16(main, city_data.unused.unknown_439c[i]);
-    }
+    buffer_write_i16_array(main, city_data.building.working_dock_ids, 10);
+    buffer_write_i16_array(main, city_data.unused.unknown_439c, 3);
     buffer_write_i16(main, city_data.figure.animals);
     buffer_write_i16(main, city_data.trade.num_sea_routes);
     buffer_write_i16(main, city_data.trade.num_land_routes);
@@ -364,9 +322,7 @@ static void save_main_data(buffer *main)
     buffer_write_i16(main, city_data.building.barracks_grid_offset);
     buffer_write_i32(main, city_data.building.barracks_building_id);
     buffer_write_i32(main, city_data.building.barracks_placed);
-    for (int i = 0; i < 5; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_43d8[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_43d8, 5);
     buffer_write_i32(main, city_data.population.lost_troop_request);
     buffer_write_i32(main, city_data.unused.unknown_43f0);
     buffer_write_i32(main, city_data.mission.has_won);
@@ -399,9 +355,7 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.sentiment.message_delay);
     buffer_write_i32(main, city_data.sentiment.low_mood_cause);
     buffer_write_i32(main, city_data.figure.security_breach_duration);
-    for (int i = 0; i < 4; i++) {
-        buffer_write_i32(main, city_data.unused.unknown_446c[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unknown_446c, 4);
     buffer_write_i32(main, city_data.emperor.selected_gift_size);
     buffer_write_i32(main, city_data.emperor.months_since_gift);
     buffer_write_i32(main, city_data.emperor.gift_overdose_penalty);
@@ -427,9 +381,7 @@ static void save_main_data(buffer *main)
     buffer_write_i32(main, city_data.resource.granaries.understaffed);
     buffer_write_i32(main, city_data.resource.granaries.not_operating);
     buffer_write_i32(main, city_data.resource.granaries.not_operating_with_food);
-    for (int i = 0; i < 2; i++) {
-        buffer_write_i32(main, city_data.unused.unused_44e0[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unused_44e0, 2);
     buffer_write_i32(main, city_data.religion.venus_curse_active);
     buffer_write_i32(main, city_data.unused.unused_44ec);
     buffer_write_i32(main, city_data.religion.neptune_double_trade_active);
@@ -447,9 +399,7 @@ static void save_main_data(buffer *main)
     buffer_write_i16(main, city_data.building.distribution_center_grid_offset);
     buffer_write_i32(main, city_data.building.distribution_center_building_id);
     buffer_write_i32(main, city_data.building.distribution_center_placed);
-    for (int i = 0; i < 11; i++) {
-        buffer_write_i32(main, city_data.unused.unused_4524[i]);
-    }
+    buffer_write_i32_array(main, city_data.unused.unused_4524, 11);
     buffer_write_i32(main, city_data.building.shipyard_boats_requested);
     buffer_write_i32(main, city_data.figure.enemies);
     buffer_write_i32(main, city_data.sentiment.wages);
@@ -550,17 +500,11 @@ static void load_main_data(buffer *main)
     city_data.population.academy_age = buffer_read_i32(main);
     city_data.population.total_capacity = buffer_read_i32(main);
     city_data.population.room_in_houses = buffer_read_i32(main);
-    for (int i = 0; i < 2400; i++) {
-        city_data.population.monthly.values[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.population.monthly.values, 2400);
     city_data.population.monthly.next_index = buffer_read_i32(main);
     city_data.population.monthly.count = buffer_read_i32(main);
-    for (int i = 0; i < 100; i++) {
-        city_data.population.at_age[i] = buffer_read_i16(main);
-    }
-    for (int i = 0; i < 20; i++) {
-        city_data.population.at_level[i] = buffer_read_i32(main);
-    }
+    buffer_read_i16_array(main, city_data.population.at_age, 100);
+    buffer_read_i32_array(main, city_data.population.at_level, 20);
     city_data.population.yearly_births = buffer_read_i32(main);
     city_data.population.yearly_deaths = buffer_read_i32(main);
     city_data.population.lost_removal = buffer_read_i32(main);
@@ -586,14 +530,10 @@ static void load_main_data(buffer *main)
     city_data.migration.immigration_duration = buffer_read_i32(main);
     city_data.migration.emigration_duration = buffer_read_i32(main);
     city_data.migration.newcomers = buffer_read_i32(main);
-    for (int i = 0; i < 4; i++) {
-        city_data.unused.unknown_27e0[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_27e0, 4);
     city_data.unused.unknown_27f0 = buffer_read_i16(main);
     city_data.resource.last_used_warehouse = buffer_read_i16(main);
-    for (int i = 0; i < 18; i++) {
-        city_data.unused.unknown_27f4[i] = buffer_read_i16(main);
-    }
+    buffer_read_i16_array(main, city_data.unused.unknown_27f4, 18);
     city_data.map.entry_point.x = buffer_read_u8(main);
     city_data.map.entry_point.y = buffer_read_u8(main);
     city_data.map.entry_point.grid_offset = buffer_read_i16(main);
@@ -605,40 +545,22 @@ static void load_main_data(buffer *main)
     city_data.building.senate_grid_offset = buffer_read_i16(main);
     city_data.building.senate_building_id = buffer_read_i32(main);
     city_data.unused.unknown_2828 = buffer_read_i16(main);
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        city_data.resource.space_in_warehouses[i] = buffer_read_i16(main);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        city_data.resource.stored_in_warehouses[i] = buffer_read_i16(main);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        city_data.resource.trade_status[i] = buffer_read_i16(main);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        city_data.resource.export_over[i] = buffer_read_i16(main);
-    }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        city_data.resource.mothballed[i] = buffer_read_i16(main);
-    }
+    buffer_read_i16_array(main, city_data.resource.space_in_warehouses, RESOURCE_MAX);
+    buffer_read_i16_array(main, city_data.resource.stored_in_warehouses, RESOURCE_MAX);
+    buffer_read_i16_array(main, city_data.resource.trade_status, RESOURCE_MAX);
+    buffer_read_i16_array(main, city_data.resource.export_over, RESOURCE_MAX);
+    buffer_read_i16_array(main, city_data.resource.mothballed, RESOURCE_MAX);
     city_data.unused.unused_28ca = buffer_read_i16(main);
-    for (int i = 0; i < RESOURCE_MAX_FOOD; i++) {
-        city_data.resource.granary_food_stored[i] = buffer_read_i32(main);
-    }
-    for (int i = 0; i < 6; i++) {
-        city_data.resource.stored_in_workshops[i] = buffer_read_i32(main);
-    }
-    for (int i = 0; i < 6; i++) {
-        city_data.resource.space_in_workshops[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.resource.granary_food_stored, RESOURCE_MAX_FOOD);
+    buffer_read_i32_array(main, city_data.resource.stored_in_workshops, 6);
+    buffer_read_i32_array(main, city_data.resource.space_in_workshops, 6);
     city_data.resource.granary_total_stored = buffer_read_i32(main);
     city_data.resource.food_types_available = buffer_read_i32(main);
     city_data.resource.food_types_eaten = buffer_read_i32(main);
     for (int i = 0; i < 272; i++) {
         city_data.unused.unknown_2924[i] = buffer_read_i8(main);
     }
-    for (int i = 0; i < RESOURCE_MAX; i++) {
-        city_data.resource.stockpiled[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.resource.stockpiled, RESOURCE_MAX);
     city_data.resource.food_supply_months = buffer_read_i32(main);
     city_data.resource.granaries.operating = buffer_read_i32(main);
     city_data.population.percentage_plebs = buffer_read_i32(main);
@@ -703,21 +625,15 @@ static void load_main_data(buffer *main)
     city_data.finance.this_year.net_in_out = buffer_read_i32(main);
     city_data.finance.last_year.balance = buffer_read_i32(main);
     city_data.finance.this_year.balance = buffer_read_i32(main);
-    for (int i = 0; i < 1400; i++) {
-        city_data.unused.unknown_2c20[i] = buffer_read_i32(main);
-    }
-    for (int i = 0; i < 8; i++) {
-        city_data.unused.houses_requiring_unknown_to_evolve[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_2c20, 1400);
+    buffer_read_i32_array(main, city_data.unused.houses_requiring_unknown_to_evolve, 8);
     city_data.trade.caravan_import_resource = buffer_read_i32(main);
     city_data.trade.caravan_backup_import_resource = buffer_read_i32(main);
     city_data.ratings.culture = buffer_read_i32(main);
     city_data.ratings.prosperity = buffer_read_i32(main);
     city_data.ratings.peace = buffer_read_i32(main);
     city_data.ratings.favor = buffer_read_i32(main);
-    for (int i = 0; i < 4; i++) {
-        city_data.unused.unknown_4238[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_4238, 4);
     city_data.ratings.prosperity_treasury_last_year = buffer_read_i32(main);
     city_data.ratings.culture_points.theater = buffer_read_i32(main);
     city_data.ratings.culture_points.religion = buffer_read_i32(main);
@@ -737,9 +653,7 @@ static void load_main_data(buffer *main)
     city_data.houses.missing.barber = buffer_read_i32(main);
     city_data.houses.missing.bathhouse = buffer_read_i32(main);
     city_data.houses.missing.food = buffer_read_i32(main);
-    for (int i = 0; i < 2; i++) {
-        city_data.unused.unknown_4294[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_4294, 2);
     city_data.building.hippodrome_placed = buffer_read_i32(main);
     city_data.houses.missing.clinic = buffer_read_i32(main);
     city_data.houses.missing.hospital = buffer_read_i32(main);
@@ -806,18 +720,12 @@ static void load_main_data(buffer *main)
     city_data.ratings.favor_explanation = buffer_read_i32(main);
     city_data.emperor.player_rank = buffer_read_i32(main);
     city_data.emperor.personal_savings = buffer_read_i32(main);
-    for (int i = 0; i < 2; i++) {
-        city_data.unused.unknown_4374[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_4374, 2);
     city_data.finance.last_year.income.donated = buffer_read_i32(main);
     city_data.finance.this_year.income.donated = buffer_read_i32(main);
     city_data.emperor.donate_amount = buffer_read_i32(main);
-    for (int i = 0; i < 10; i++) {
-        city_data.building.working_dock_ids[i] = buffer_read_i16(main);
-    }
-    for (int i = 0; i < 3; i++) {
-        city_data.unused.unknown_439c[i] = buffer_read_i16(main);
-    }
+    buffer_read_i16_array(main, city_data.building.working_dock_ids, 10);
+    buffer_read_i16_array(main, city_data.unused.unknown_439c, 3);
     city_data.figure.animals = buffer_read_i16(main);
     city_data.trade.num_sea_routes = buffer_read_i16(main);
     city_data.trade.num_land_routes = buffer_read_i16(main);
@@ -841,9 +749,7 @@ static void load_main_data(buffer *main)
     city_data.building.barracks_grid_offset = buffer_read_i16(main);
     city_data.building.barracks_building_id = buffer_read_i32(main);
     city_data.building.barracks_placed = buffer_read_i32(main);
-    for (int i = 0; i < 5; i++) {
-        city_data.unused.unknown_43d8[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_43d8, 5);
     city_data.population.lost_troop_request = buffer_read_i32(main);
     city_data.unused.unknown_43f0 = buffer_read_i32(main);
     city_data.mission.has_won = buffer_read_i32(main);
@@ -876,9 +782,7 @@ static void load_main_data(buffer *main)
     city_data.sentiment.message_delay = buffer_read_i32(main);
     city_data.sentiment.low_mood_cause = buffer_read_i32(main);
     city_data.figure.security_breach_duration = buffer_read_i32(main);
-    for (int i = 0; i < 4; i++) {
-        city_data.unused.unknown_446c[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unknown_446c, 4);
     city_data.emperor.selected_gift_size = buffer_read_i32(main);
     city_data.emperor.months_since_gift = buffer_read_i32(main);
     city_data.emperor.gift_overdose_penalty = buffer_read_i32(main);
@@ -904,9 +808,7 @@ static void load_main_data(buffer *main)
     city_data.resource.granaries.understaffed = buffer_read_i32(main);
     city_data.resource.granaries.not_operating = buffer_read_i32(main);
     city_data.resource.granaries.not_operating_with_food = buffer_read_i32(main);
-    for (int i = 0; i < 2; i++) {
-        city_data.unused.unused_44e0[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unused_44e0, 2);
     city_data.religion.venus_curse_active = buffer_read_i32(main);
     city_data.unused.unused_44ec = buffer_read_i32(main);
     city_data.religion.neptune_double_trade_active = buffer_read_i32(main);
@@ -924,9 +826,7 @@ static void load_main_data(buffer *main)
     city_data.building.distribution_center_grid_offset = buffer_read_i16(main);
     city_data.building.distribution_center_building_id = buffer_read_i32(main);
     city_data.building.distribution_center_placed = buffer_read_i32(main);
-    for (int i = 0; i < 11; i++) {
-        city_data.unused.unused_4524[i] = buffer_read_i32(main);
-    }
+    buffer_read_i32_array(main, city_data.unused.unused_4524, 11);
     city_data.building.shipyard_boats_requested = buffer_read_i32(main);
     city_data.figure.enemies = buffer_read_i32(main);
     city_data.sentiment.wages = buffer_read_i32(main);
@@ -1039,6 +939,16 @@ void city_data_save_state(buffer *main, buffer *faction, buffer *faction_unknown
     save_entry_exit(entry_exit_xy, entry_exit_grid_offset);
 }
 
+void city_data_read_summary(buffer *main, int *treasury, int *population)
+{
+    // other player data and unknown bytes, tax percentage
+    buffer_skip(main, 18068 + 8 + 4);
+    *treasury = buffer_read_i32(main);
+    // sentiment, health target and value, hospital workers, unknown
+    buffer_skip(main, 20);
+    *population = buffer_read_i32(main);
+}
+
 void city_data_load_state(buffer *main, buffer *faction, buffer *faction_unknown, buffer *graph_order,
                           buffer *entry_exit_xy, buffer *entry_exit_grid_offset)
 {
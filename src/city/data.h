@@ -15,4 +15,12 @@ void city_data_save_state(buffer *main, buffer *faction, buffer *faction_unknown
 void city_data_load_state(buffer *main, buffer *faction, buffer *faction_unknown, buffer *graph_order,
                           buffer *entry_exit_xy, buffer *entry_exit_grid_offset);
 
+/**
+ * Reads the treasury and population from a saved city data piece, without loading it
+ * @param main City data piece
+ * @param treasury Treasury of the saved city
+ * @param population Population of the saved city
+ */
+void city_data_read_summary(buffer *main, int *treasury, int *population);
+
 #endif // CITY_DATA_H
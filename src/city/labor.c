@@ -55,6 +55,13 @@ static struct {
     {LABOR_CATEGORY_GOVERNANCE_RELIGION, 1},
 };
 
+// buildings in use that have a labor category, grouped by category and sorted by id.
+// Rebuilt by a full sweep at each allocation: buildings are not tracked as they change
+static struct {
+    int start[MAX_CATS + 1];
+    int items[MAX_BUILDINGS];
+} category_buildings;
+
 int city_labor_unemployment_percentage(void)
 {
     return city_data.labor.unemployment_percentage;
@@ -166,6 +173,39 @@ static int should_have_workers(building *b, int category, int check_access)
     return 1;
 }
 
+static void update_category_buildings(int set_labor_category)
+{
+    static int ids[MAX_BUILDINGS];
+    static unsigned char categories[MAX_BUILDINGS];
+    int count[MAX_CATS] = {0};
+    int total = 0;
+    for (int i = 1; i < MAX_BUILDINGS; i++) {
+        building *b = building_get(i);
+        if (b->state != BUILDING_STATE_IN_USE) {
+            continue;
+        }
+        int category = CATEGORY_FOR_BUILDING_TYPE[b->type];
+        if (set_labor_category) {
+            b->labor_category = category;
+        }
+        if (category >= 0) {
+            ids[total] = i;
+            categories[total] = category;
+            count[category]++;
+            total++;
+        }
+    }
+    int next[MAX_CATS];
+    category_buildings.start[0] = 0;
+    for (int cat = 0; cat < MAX_CATS; cat++) {
+        next[cat] = category_buildings.start[cat];
+        category_buildings.start[cat + 1] = category_buildings.start[cat] + count[cat];
+    }
+    for (int i = 0; i < total; i++) {
+        category_buildings.items[next[categories[i]]++] = ids[i];
+    }
+}
+
 static void calculate_workers_needed_per_category(void)
 {
     for (int cat = 0; cat < MAX_CATS; cat++) {
@@ -174,19 +214,17 @@ static void calculate_workers_needed_per_category(void)
         city_data.labor.categories[cat].workers_allocated = 0;
         city_data.labor.categories[cat].workers_needed = 0;
     }
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        int category = CATEGORY_FOR_BUILDING_TYPE[b->type];
-        b->labor_category = category;
-        if (!should_have_workers(b, category, 1)) {
-            continue;
+    update_category_buildings(1);
+    for (int cat = 0; cat < MAX_CATS; cat++) {
+        for (int i = category_buildings.start[cat]; i < category_buildings.start[cat + 1]; i++) {
+            building *b = building_get(category_buildings.items[i]);
+            if (!should_have_workers(b, cat, 1)) {
+                continue;
+            }
+            city_data.labor.categories[cat].workers_needed += model_get_building(b->type)->laborers;
+            city_data.labor.categories[cat].total_houses_covered += b->houses_covered;
+            city_data.labor.categories[cat].buildings++;
         }
-        city_data.labor.categories[category].workers_needed += model_get_building(b->type)->laborers;
-        city_data.labor.categories[category].total_houses_covered += b->houses_covered;
-        city_data.labor.categories[category].buildings++;
     }
 }
 
@@ -288,15 +326,13 @@ static void check_employment(void)
 static void set_building_worker_weight(void)
 {
     int water_per_10k_per_building = calc_percentage(100, city_data.labor.categories[LABOR_CATEGORY_WATER].buildings);
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        int cat = CATEGORY_FOR_BUILDING_TYPE[b->type];
-        if (cat == LABOR_CATEGORY_WATER) {
-            b->percentage_houses_covered = water_per_10k_per_building;
-        } else if (cat >= 0) {
+    for (int cat = 0; cat < MAX_CATS; cat++) {
+        for (int i = category_buildings.start[cat]; i < category_buildings.start[cat + 1]; i++) {
+            building *b = building_get(category_buildings.items[i]);
+            if (cat == LABOR_CATEGORY_WATER) {
+                b->percentage_houses_covered = water_per_10k_per_building;
+                continue;
+            }
             b->percentage_houses_covered = 0;
             if (b->houses_covered) {
                 b->percentage_houses_covered =
@@ -322,16 +358,20 @@ static void allocate_workers_to_water(void)
     } else {
         workers_per_building = water_cat->workers_allocated / (water_cat->buildings - buildings_to_skip);
     }
-    int building_id = start_building_id;
+    // visit water buildings in id order, wrapping around from the last building that got workers
+    int first = category_buildings.start[LABOR_CATEGORY_WATER];
+    int last = category_buildings.start[LABOR_CATEGORY_WATER + 1];
+    int offset = first;
+    while (offset < last && category_buildings.items[offset] < start_building_id) {
+        offset++;
+    }
     start_building_id = 0;
-    for (int guard = 1; guard < MAX_BUILDINGS; guard++, building_id++) {
-        if (building_id >= MAX_BUILDINGS) {
-            building_id = 1;
+    for (int i = first; i < last; i++, offset++) {
+        if (offset >= last) {
+            offset = first;
         }
+        int building_id = category_buildings.items[offset];
         building *b = building_get(building_id);
-        if (b->state != BUILDING_STATE_IN_USE || CATEGORY_FOR_BUILDING_TYPE[b->type] != LABOR_CATEGORY_WATER) {
-            continue;
-        }
         b->num_workers = 0;
         if (b->percentage_houses_covered > 0) {
             if (percentage_not_filled > 0) {
@@ -364,33 +404,32 @@ static void allocate_workers_to_non_water_buildings(void)
             city_data.labor.categories[i].workers_allocated < city_data.labor.categories[i].workers_needed
             ? 1 : 0;
     }
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        int cat = CATEGORY_FOR_BUILDING_TYPE[b->type];
-        if (cat == LABOR_CATEGORY_WATER || cat < 0) {
+    // categories are independent, so handling them one after the other matches a single pass by id
+    for (int cat = 0; cat < MAX_CATS; cat++) {
+        if (cat == LABOR_CATEGORY_WATER) {
             // water is handled by allocate_workers_to_water(void)
             continue;
         }
-        b->num_workers = 0;
-        if (!should_have_workers(b, cat, 0)) {
-            continue;
-        }
-        if (b->percentage_houses_covered > 0) {
-            int required_workers = model_get_building(b->type)->laborers;
-            if (category_workers_needed[cat]) {
-                int num_workers = calc_adjust_with_percentage(
-                    city_data.labor.categories[cat].workers_allocated,
-                    b->percentage_houses_covered) / 100;
-                if (num_workers > required_workers) {
-                    num_workers = required_workers;
+        for (int i = category_buildings.start[cat]; i < category_buildings.start[cat + 1]; i++) {
+            building *b = building_get(category_buildings.items[i]);
+            b->num_workers = 0;
+            if (!should_have_workers(b, cat, 0)) {
+                continue;
+            }
+            if (b->percentage_houses_covered > 0) {
+                int required_workers = model_get_building(b->type)->laborers;
+                if (category_workers_needed[cat]) {
+                    int num_workers = calc_adjust_with_percentage(
+                        city_data.labor.categories[cat].workers_allocated,
+                        b->percentage_houses_covered) / 100;
+                    if (num_workers > required_workers) {
+                        num_workers = required_workers;
+                    }
+                    b->num_workers = num_workers;
+                    category_workers_allocated[cat] += num_workers;
+                } else {
+                    b->num_workers = required_workers;
                 }
-                b->num_workers = num_workers;
-                category_workers_allocated[cat] += num_workers;
-            } else {
-                b->num_workers = required_workers;
             }
         }
     }
@@ -406,28 +445,26 @@ static void allocate_workers_to_non_water_buildings(void)
             }
         }
     }
-    for (int i = 1; i < MAX_BUILDINGS; i++) {
-        building *b = building_get(i);
-        if (b->state != BUILDING_STATE_IN_USE) {
-            continue;
-        }
-        int cat = CATEGORY_FOR_BUILDING_TYPE[b->type];
-        if (cat < 0 || cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_MILITARY) {
-            continue;
-        }
-        if (!should_have_workers(b, cat, 0)) {
+    for (int cat = 0; cat < MAX_CATS; cat++) {
+        if (cat == LABOR_CATEGORY_WATER || cat == LABOR_CATEGORY_MILITARY || !category_workers_needed[cat]) {
             continue;
         }
-        if (b->percentage_houses_covered > 0 && category_workers_needed[cat]) {
-            int required_workers = model_get_building(b->type)->laborers;
-            if (b->num_workers < required_workers) {
-                int needed = required_workers - b->num_workers;
-                if (needed > category_workers_needed[cat]) {
-                    b->num_workers += category_workers_needed[cat];
-                    category_workers_needed[cat] = 0;
-                } else {
-                    b->num_workers += needed;
-                    category_workers_needed[cat] -= needed;
+        for (int i = category_buildings.start[cat]; i < category_buildings.start[cat + 1]; i++) {
+            building *b = building_get(category_buildings.items[i]);
+            if (!should_have_workers(b, cat, 0)) {
+                continue;
+            }
+            if (b->percentage_houses_covered > 0 && category_workers_needed[cat]) {
+                int required_workers = model_get_building(b->type)->laborers;
+                if (b->num_workers < required_workers) {
+                    int needed = required_workers - b->num_workers;
+                    if (needed > category_workers_needed[cat]) {
+                        b->num_workers += category_workers_needed[cat];
+                        category_workers_needed[cat] = 0;
+                    } else {
+                        b->num_workers += needed;
+                        category_workers_needed[cat] -= needed;
+                    }
                 }
             }
         }
@@ -443,6 +480,7 @@ static void allocate_workers_to_buildings(void)
 
 void city_labor_allocate_workers(void)
 {
+    update_category_buildings(0);
     allocate_workers_to_categories();
     allocate_workers_to_buildings();
 }
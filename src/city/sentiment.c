@@ -30,6 +30,9 @@ int city_sentiment_low_mood_cause(void)
 void city_sentiment_change_happiness(int amount)
 {
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             b->sentiment.house_happiness = calc_bound(b->sentiment.house_happiness + amount, 0, 100);
@@ -40,6 +43,9 @@ void city_sentiment_change_happiness(int amount)
 void city_sentiment_set_max_happiness(int max)
 {
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size) {
             if (b->sentiment.house_happiness > max) {
@@ -178,6 +184,9 @@ void city_sentiment_update(void)
     int total_sentiment_penalty_tents = 0;
     int default_sentiment = difficulty_sentiment();
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state != BUILDING_STATE_IN_USE || !b->house_size) {
             continue;
@@ -251,6 +260,9 @@ void city_sentiment_update(void)
     int total_sentiment = 0;
     int total_houses = 0;
     for (int i = 1; i < MAX_BUILDINGS; i++) {
+        if (!building_may_be_house(i)) {
+            continue;
+        }
         building *b = building_get(i);
         if (b->state == BUILDING_STATE_IN_USE && b->house_size && b->house_population) {
             total_houses++;
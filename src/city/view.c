@@ -38,6 +38,7 @@ static struct {
 } data;
 
 static int view_to_grid_offset_lookup[VIEW_X_MAX][VIEW_Y_MAX];
+static int grid_offset_to_view_lookup[GRID_SIZE * GRID_SIZE];
 
 static void check_camera_boundaries(void)
 {
@@ -71,6 +72,22 @@ static void reset_lookup(void)
     }
 }
 
+static void calculate_reverse_lookup(void)
+{
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        grid_offset_to_view_lookup[i] = -1;
+    }
+    // first match in view order, like a search through the view lookup would find
+    for (int y = 0; y < VIEW_Y_MAX; y++) {
+        for (int x = 0; x < VIEW_X_MAX; x++) {
+            int grid_offset = view_to_grid_offset_lookup[x][y];
+            if (grid_offset >= 0 && grid_offset_to_view_lookup[grid_offset] < 0) {
+                grid_offset_to_view_lookup[grid_offset] = y * VIEW_X_MAX + x;
+            }
+        }
+    }
+}
+
 static void calculate_lookup(void)
 {
     reset_lookup();
@@ -132,6 +149,7 @@ static void calculate_lookup(void)
         x_view_start += x_view_skip;
         y_view_start += y_view_skip;
     }
+    calculate_reverse_lookup();
 }
 
 static void adjust_camera_position_for_pixels(void)
@@ -264,18 +282,19 @@ void city_view_scroll(int x, int y)
     check_camera_boundaries();
 }
 
-void city_view_grid_offset_to_xy_view(int grid_offset, int *x_view, int *y_view)
+int city_view_grid_offset_to_xy_view(int grid_offset, int *x_view, int *y_view)
 {
     *x_view = *y_view = 0;
-    for (int y = 0; y < VIEW_Y_MAX; y++) {
-        for (int x = 0; x < VIEW_X_MAX; x++) {
-            if (view_to_grid_offset_lookup[x][y] == grid_offset) {
-                *x_view = x;
-                *y_view = y;
-                return;
-            }
-        }
+    if (grid_offset < 0 || grid_offset >= GRID_SIZE * GRID_SIZE) {
+        return 0;
     }
+    int view = grid_offset_to_view_lookup[grid_offset];
+    if (view < 0) {
+        return 0;
+    }
+    *x_view = view % VIEW_X_MAX;
+    *y_view = view / VIEW_X_MAX;
+    return 1;
 }
 
 void city_view_get_selected_tile_pixels(int *x_pixels, int *y_pixels)
@@ -524,6 +543,35 @@ void city_view_foreach_map_tile(map_callback *callback)
     }
 }
 
+void city_view_foreach_map_tile_in_pixel_rows(map_callback *callback, int y_min, int y_max)
+{
+    int odd = 0;
+    int y_view = data.camera.tile.y - 8;
+    int y_graphic = data.viewport.y - 9 * HALF_TILE_HEIGHT_PIXELS - data.camera.pixel.y;
+    for (int y = 0; y < data.viewport.height_tiles + 21 && y_graphic < y_max; y++) {
+        if (y_view >= 0 && y_view < VIEW_Y_MAX && y_graphic >= y_min) {
+            int x_graphic = -(4 * TILE_WIDTH_PIXELS) - data.camera.pixel.x;
+            if (odd) {
+                x_graphic += data.viewport.x - HALF_TILE_WIDTH_PIXELS;
+            } else {
+                x_graphic += data.viewport.x;
+            }
+            int x_view = data.camera.tile.x - 4;
+            for (int x = 0; x < data.viewport.width_tiles + 7; x++) {
+                if (x_view >= 0 && x_view < VIEW_X_MAX) {
+                    int grid_offset = view_to_grid_offset_lookup[x_view][y_view];
+                    callback(x_graphic, y_graphic, grid_offset);
+                }
+                x_graphic += TILE_WIDTH_PIXELS;
+                x_view++;
+            }
+        }
+        odd = 1 - odd;
+        y_graphic += HALF_TILE_HEIGHT_PIXELS;
+        y_view++;
+    }
+}
+
 void city_view_foreach_valid_map_tile(map_callback *callback)
 {
     int odd = 0;
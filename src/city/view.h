@@ -32,7 +32,14 @@ void city_view_set_camera_from_pixel_position(int x, int y);
 
 void city_view_scroll(int x, int y);
 
-void city_view_grid_offset_to_xy_view(int grid_offset, int *x_view, int *y_view);
+/**
+ * Gets the view position of a tile
+ * @param grid_offset Tile
+ * @param x_view X position in the view, 0 if the tile is not visible
+ * @param y_view Y position in the view, 0 if the tile is not visible
+ * @return Boolean true if the tile is visible in the view
+ */
+int city_view_grid_offset_to_xy_view(int grid_offset, int *x_view, int *y_view);
 
 void city_view_get_selected_tile_pixels(int *x_pixels, int *y_pixels);
 
@@ -69,6 +76,12 @@ void city_view_load_scenario_state(buffer *camera);
 
 void city_view_foreach_map_tile(map_callback *callback);
 
+/**
+ * Same as city_view_foreach_map_tile, but only for tiles with a pixel y coordinate
+ * in the range [y_min, y_max)
+ */
+void city_view_foreach_map_tile_in_pixel_rows(map_callback *callback, int y_min, int y_max);
+
 void city_view_foreach_valid_map_tile(map_callback *callback);
 
 void city_view_foreach_valid_map_tile_row(map_callback *callback1, map_callback *callback2, map_callback *callback3);
@@ -30,6 +30,88 @@ static int check_size(buffer *buf, int size)
     return 1;
 }
 
+static int is_little_endian(void)
+{
+    const uint16_t one = 1;
+    return *(const uint8_t *) &one;
+}
+
+// Number of whole values of the given width that fit, flagging overflow when not all of them do
+static int check_array_size(buffer *buf, int count, int width)
+{
+    int available = buf->size > buf->index ? (buf->size - buf->index) / width : 0;
+    if (count > available) {
+        buf->overflow = 1;
+        return available;
+    }
+    return count;
+}
+
+static void write_array_16(buffer *buf, const uint16_t *values, int count)
+{
+    count = check_array_size(buf, count, 2);
+    uint8_t *dst = &buf->data[buf->index];
+    if (is_little_endian()) {
+        memcpy(dst, values, 2 * count);
+    } else {
+        for (int i = 0; i < count; i++) {
+            dst[2 * i] = values[i] & 0xff;
+            dst[2 * i + 1] = (values[i] >> 8) & 0xff;
+        }
+    }
+    buf->index += 2 * count;
+}
+
+static void write_array_32(buffer *buf, const uint32_t *values, int count)
+{
+    count = check_array_size(buf, count, 4);
+    uint8_t *dst = &buf->data[buf->index];
+    if (is_little_endian()) {
+        memcpy(dst, values, 4 * count);
+    } else {
+        for (int i = 0; i < count; i++) {
+            dst[4 * i] = values[i] & 0xff;
+            dst[4 * i + 1] = (values[i] >> 8) & 0xff;
+            dst[4 * i + 2] = (values[i] >> 16) & 0xff;
+            dst[4 * i + 3] = (values[i] >> 24) & 0xff;
+        }
+    }
+    buf->index += 4 * count;
+}
+
+static void read_array_16(buffer *buf, uint16_t *values, int count)
+{
+    int available = check_array_size(buf, count, 2);
+    const uint8_t *src = &buf->data[buf->index];
+    if (is_little_endian()) {
+        memcpy(values, src, 2 * available);
+    } else {
+        for (int i = 0; i < available; i++) {
+            values[i] = (uint16_t) (src[2 * i] | (src[2 * i + 1] << 8));
+        }
+    }
+    // Values beyond the end of the buffer read as 0
+    memset(&values[available], 0, 2 * (count - available));
+    buf->index += 2 * available;
+}
+
+static void read_array_32(buffer *buf, uint32_t *values, int count)
+{
+    int available = check_array_size(buf, count, 4);
+    const uint8_t *src = &buf->data[buf->index];
+    if (is_little_endian()) {
+        memcpy(values, src, 4 * available);
+    } else {
+        for (int i = 0; i < available; i++) {
+            values[i] = (uint32_t) src[4 * i] | ((uint32_t) src[4 * i + 1] << 8) |
+                ((uint32_t) src[4 * i + 2] << 16) | ((uint32_t) src[4 * i + 3] << 24);
+        }
+    }
+    // Values beyond the end of the buffer read as 0
+    memset(&values[available], 0, 4 * (count - available));
+    buf->index += 4 * available;
+}
+
 void buffer_write_u8(buffer *buf, uint8_t value)
 {
     if (check_size(buf, 1)) {
@@ -88,6 +170,21 @@ void buffer_write_raw(buffer *buf, const void *value, int size)
     }
 }
 
+void buffer_write_u16_array(buffer *buf, const uint16_t *values, int count)
+{
+    write_array_16(buf, values, count);
+}
+
+void buffer_write_i16_array(buffer *buf, const int16_t *values, int count)
+{
+    write_array_16(buf, (const uint16_t *) values, count);
+}
+
+void buffer_write_i32_array(buffer *buf, const int32_t *values, int count)
+{
+    write_array_32(buf, (const uint32_t *) values, count);
+}
+
 uint8_t buffer_read_u8(buffer *buf)
 {
     if (check_size(buf, 1)) {
@@ -165,6 +262,21 @@ int buffer_read_raw(buffer *buf, void *value, int max_size)
     return size;
 }
 
+void buffer_read_u16_array(buffer *buf, uint16_t *values, int count)
+{
+    read_array_16(buf, values, count);
+}
+
+void buffer_read_i16_array(buffer *buf, int16_t *values, int count)
+{
+    read_array_16(buf, (uint16_t *) values, count);
+}
+
+void buffer_read_i32_array(buffer *buf, int32_t *values, int count)
+{
+    read_array_32(buf, (uint32_t *) values, count);
+}
+
 void buffer_skip(buffer *buf, int size)
 {
     buf->index += size;
@@ -89,6 +89,30 @@ void buffer_write_i32(buffer *buffer, int32_t value);
  */
 void buffer_write_raw(buffer *buffer, const void *value, int size);
 
+/**
+ * Writes an array of unsigned 16-bit integers, equivalent to calling buffer_write_u16() for each value
+ * @param buffer Buffer
+ * @param values Values to write
+ * @param count Number of values
+ */
+void buffer_write_u16_array(buffer *buffer, const uint16_t *values, int count);
+
+/**
+ * Writes an array of signed 16-bit integers, equivalent to calling buffer_write_i16() for each value
+ * @param buffer Buffer
+ * @param values Values to write
+ * @param count Number of values
+ */
+void buffer_write_i16_array(buffer *buffer, const int16_t *values, int count);
+
+/**
+ * Writes an array of signed 32-bit integers, equivalent to calling buffer_write_i32() for each value
+ * @param buffer Buffer
+ * @param values Values to write
+ * @param count Number of values
+ */
+void buffer_write_i32_array(buffer *buffer, const int32_t *values, int count);
+
 /**
  * Reads an unsigned 8-bit integer
  * @param buffer Buffer
@@ -140,6 +164,30 @@ int32_t buffer_read_i32(buffer *buffer);
  */
 int buffer_read_raw(buffer *buffer, void *value, int max_size);
 
+/**
+ * Reads an array of unsigned 16-bit integers, equivalent to calling buffer_read_u16() for each value
+ * @param buffer Buffer
+ * @param values Values to read into
+ * @param count Number of values
+ */
+void buffer_read_u16_array(buffer *buffer, uint16_t *values, int count);
+
+/**
+ * Reads an array of signed 16-bit integers, equivalent to calling buffer_read_i16() for each value
+ * @param buffer Buffer
+ * @param values Values to read into
+ * @param count Number of values
+ */
+void buffer_read_i16_array(buffer *buffer, int16_t *values, int count);
+
+/**
+ * Reads an array of signed 32-bit integers, equivalent to calling buffer_read_i32() for each value
+ * @param buffer Buffer
+ * @param values Values to read into
+ * @param count Number of values
+ */
+void buffer_read_i32_array(buffer *buffer, int32_t *values, int count);
+
 /**
  * Skip data in the buffer
  * @param buffer Buffer
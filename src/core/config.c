@@ -14,8 +14,11 @@ static const char *INI_FILENAME = "julius.ini";
 static const char *ini_keys[] = {
     "gameplay_fix_immigration",
     "gameplay_fix_100y_ghosts",
+    "gameplay_autosave_slots",
     "screen_display_scale",
     "screen_cursor_scale",
+    "screen_threaded_drawing",
+    "screen_verify_threaded_drawing",
     "ui_sidebar_info",
     "ui_show_intro_video",
     "ui_smooth_scrolling",
@@ -38,6 +41,7 @@ static int values[CONFIG_MAX_ENTRIES];
 static char string_values[CONFIG_STRING_MAX_ENTRIES][CONFIG_STRING_VALUE_MAX];
 
 static int default_values[CONFIG_MAX_ENTRIES] = {
+    [CONFIG_GP_AUTOSAVE_SLOTS] = 1,
     [CONFIG_SCREEN_DISPLAY_SCALE] = 100,
     [CONFIG_SCREEN_CURSOR_SCALE] = 100
 };
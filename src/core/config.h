@@ -6,8 +6,11 @@
 typedef enum {
     CONFIG_GP_FIX_IMMIGRATION_BUG,
     CONFIG_GP_FIX_100_YEAR_GHOSTS,
+    CONFIG_GP_AUTOSAVE_SLOTS,
     CONFIG_SCREEN_DISPLAY_SCALE,
     CONFIG_SCREEN_CURSOR_SCALE,
+    CONFIG_SCREEN_THREADED_DRAWING,
+    CONFIG_SCREEN_VERIFY_THREADED_DRAWING,
     CONFIG_UI_SIDEBAR_INFO,
     CONFIG_UI_SHOW_INTRO_VIDEO,
     CONFIG_UI_SMOOTH_SCROLLING,
@@ -2,18 +2,21 @@
 
 #include "core/config.h"
 #include "core/file.h"
+#include "core/hash.h"
 #include "core/string.h"
+#include "core/thread.h"
 #include "platform/file_manager.h"
 
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define BASE_MAX_FILES 100
+#define INDEX_BASE_NAMES 64
 
 static struct {
     dir_listing listing;
     int max_files;
-    char *cased_filename;
 } data;
 
 static void allocate_listing_files(int min, int max)
@@ -65,9 +68,16 @@ static int add_to_listing(const char *filename)
 }
 
 const dir_listing *dir_find_files_with_extension(const char *extension)
+{
+    return dir_find_files_with_extensions(&extension, 1);
+}
+
+const dir_listing *dir_find_files_with_extensions(const char *const *extensions, int num_extensions)
 {
     clear_dir_listing();
-    platform_file_manager_list_directory_contents(0, TYPE_FILE, extension, add_to_listing);
+    for (int i = 0; i < num_extensions; i++) {
+        platform_file_manager_list_directory_contents(0, TYPE_FILE, extensions[i], add_to_listing);
+    }
     qsort(data.listing.files, data.listing.num_files, sizeof(char*), compare_lower);
     return &data.listing;
 }
@@ -80,33 +90,181 @@ const dir_listing *dir_find_all_subdirectories(void)
     return &data.listing;
 }
 
-static int compare_case(const char *filename)
+// Case-insensitive index of the names in one directory, as an open-addressing hash table
+typedef struct {
+    char path[FILE_NAME_MAX];
+    char **names;
+    int num_names;
+    int max_names;
+    int *slots;
+    int slot_mask;
+} dir_index;
+
+static struct {
+    dir_index **items;
+    int num_items;
+    dir_index *building;
+    thread_mutex *mutex;
+    int mutex_created;
+} indexes;
+
+static uint64_t hash_name(const char *name)
+{
+    char folded[FILE_NAME_MAX];
+    int length = 0;
+    while (name[length] && length < FILE_NAME_MAX - 1) {
+        folded[length] = (char) tolower((unsigned char) name[length]);
+        length++;
+    }
+    return hash_data(folded, length);
+}
+
+static void insert_slot(dir_index *index, int name_id)
+{
+    int slot = (int) (hash_name(index->names[name_id]) & index->slot_mask);
+    while (index->slots[slot]) {
+        slot = (slot + 1) & index->slot_mask;
+    }
+    index->slots[slot] = name_id + 1;
+}
+
+static int grow_index(dir_index *index)
+{
+    int max_names = index->max_names ? 2 * index->max_names : INDEX_BASE_NAMES;
+    char **names = (char **) realloc(index->names, max_names * sizeof(char *));
+    // Keep the table at most half full
+    int *slots = (int *) malloc(2 * max_names * sizeof(int));
+    if (!names || !slots) {
+        if (names) {
+            index->names = names;
+        }
+        free(slots);
+        return 0;
+    }
+    index->names = names;
+    index->max_names = max_names;
+    free(index->slots);
+    index->slots = slots;
+    index->slot_mask = 2 * max_names - 1;
+    memset(index->slots, 0, 2 * max_names * sizeof(int));
+    for (int i = 0; i < index->num_names; i++) {
+        insert_slot(index, i);
+    }
+    return 1;
+}
+
+static int add_to_index(const char *filename)
 {
-    if (platform_file_manager_compare_filename(filename, data.cased_filename) == 0) {
-        strcpy(data.cased_filename, filename);
+    dir_index *index = indexes.building;
+    if (index->num_names >= index->max_names && !grow_index(index)) {
+        return LIST_MATCH;
+    }
+    size_t length = strlen(filename) + 1;
+    char *name = (char *) malloc(length);
+    if (!name) {
         return LIST_MATCH;
     }
-    return LIST_NO_MATCH;
+    memcpy(name, filename, length);
+    index->names[index->num_names] = name;
+    insert_slot(index, index->num_names);
+    index->num_names++;
+    return LIST_CONTINUE;
+}
+
+static void free_index(dir_index *index)
+{
+    for (int i = 0; i < index->num_names; i++) {
+        free(index->names[i]);
+    }
+    free(index->names);
+    free(index->slots);
+    free(index);
+}
+
+static dir_index *get_index(const char *path)
+{
+    for (int i = 0; i < indexes.num_items; i++) {
+        if (strcmp(indexes.items[i]->path, path) == 0) {
+            return indexes.items[i];
+        }
+    }
+    dir_index **items = (dir_index **) realloc(indexes.items, (indexes.num_items + 1) * sizeof(dir_index *));
+    if (!items) {
+        return 0;
+    }
+    indexes.items = items;
+    dir_index *index = (dir_index *) calloc(1, sizeof(dir_index));
+    if (!index) {
+        return 0;
+    }
+    strncpy(index->path, path, FILE_NAME_MAX - 1);
+    if (!grow_index(index)) {
+        free_index(index);
+        return 0;
+    }
+    // A directory that cannot be listed gets an empty index, so it is not listed again
+    indexes.building = index;
+    platform_file_manager_list_directory_contents(*path ? path : 0, TYPE_FILE | TYPE_DIR, 0, add_to_index);
+    indexes.building = 0;
+    indexes.items[indexes.num_items++] = index;
+    return index;
+}
+
+static const char *find_in_index(const dir_index *index, const char *name)
+{
+    // Prefer an exact match, for file systems that allow names that only differ in case
+    const char *match = 0;
+    int slot = (int) (hash_name(name) & index->slot_mask);
+    while (index->slots[slot]) {
+        const char *candidate = index->names[index->slots[slot] - 1];
+        if (strcmp(candidate, name) == 0) {
+            return candidate;
+        }
+        if (!match && platform_file_manager_compare_filename(candidate, name) == 0) {
+            match = candidate;
+        }
+        slot = (slot + 1) & index->slot_mask;
+    }
+    return match;
 }
 
-static int correct_case(const char *dir, char *filename, int type)
+static void lock_indexes(void)
 {
-    data.cased_filename = filename;
-    return platform_file_manager_list_directory_contents(dir, type, 0, compare_case) == LIST_MATCH;
+    // The first lookup happens on the main thread during start-up, before any other threads exist
+    if (!indexes.mutex_created) {
+        indexes.mutex = thread_mutex_create();
+        indexes.mutex_created = 1;
+    }
+    if (indexes.mutex) {
+        thread_mutex_lock(indexes.mutex);
+    }
 }
 
-static void move_left(char *str)
+static void unlock_indexes(void)
 {
-    while (*str) {
-        str[0] = str[1];
-        str++;
+    if (indexes.mutex) {
+        thread_mutex_unlock(indexes.mutex);
     }
-    *str = 0;
+}
+
+static int is_separator(char c)
+{
+    return c == '/' || c == '\\';
+}
+
+static const char *file_if_exists(const char *filename)
+{
+    FILE *fp = file_open(filename, "rb");
+    if (fp) {
+        file_close(fp);
+        return filename;
+    }
+    return 0;
 }
 
 static const char *get_case_corrected_file(const char *dir, const char *filepath)
 {
-    static char corrected_filename[2 * FILE_NAME_MAX];
+    static THREAD_LOCAL char corrected_filename[2 * FILE_NAME_MAX];
     corrected_filename[2 * FILE_NAME_MAX - 1] = 0;
 
     size_t dir_len = 0;
@@ -114,45 +272,60 @@ static const char *get_case_corrected_file(const char *dir, const char *filepath
         dir_len = strlen(dir) + 1;
         strncpy(corrected_filename, dir, 2 * FILE_NAME_MAX - 1);
         corrected_filename[dir_len - 1] = '/';
-    } else {
-        dir = ".";
     }
-
     strncpy(&corrected_filename[dir_len], filepath, 2 * FILE_NAME_MAX - dir_len - 1);
 
-    FILE *fp = file_open(corrected_filename, "rb");
-    if (fp) {
-        file_close(fp);
-        return corrected_filename;
-    }
-
     if (!platform_file_manager_should_case_correct_file()) {
-        return 0;
+        return file_if_exists(corrected_filename);
     }
 
-    char *slash = strchr(&corrected_filename[dir_len], '/');
-    if (!slash) {
-        slash = strchr(&corrected_filename[dir_len], '\\');
-    }
-    if (slash) {
-        *slash = 0;
-        if (correct_case(dir, &corrected_filename[dir_len], TYPE_DIR)) {
-            char *path = slash + 1;
-            if (*path == '\\') {
-                // double backslash: move everything to the left
-                move_left(path);
-            }
-            if (correct_case(corrected_filename, path, TYPE_FILE)) {
-                *slash = '/';
-                return corrected_filename;
-            }
+    // Look up each part of the path in the index of its directory
+    char path[2 * FILE_NAME_MAX];
+    size_t path_len = dir_len ? dir_len - 1 : 0;
+    memcpy(path, corrected_filename, path_len);
+    path[path_len] = 0;
+    const char *part = filepath;
+    int found = 1;
+    lock_indexes();
+    while (*part && found) {
+        while (is_separator(*part)) {
+            part++;
         }
-    } else {
-        if (correct_case(dir, &corrected_filename[dir_len], TYPE_FILE)) {
-            return corrected_filename;
+        size_t part_len = 0;
+        while (part[part_len] && !is_separator(part[part_len])) {
+            part_len++;
+        }
+        if (!part_len) {
+            break;
+        }
+        char name[FILE_NAME_MAX];
+        if (part_len >= FILE_NAME_MAX || path_len + part_len + 2 > sizeof(path)) {
+            found = 0;
+            break;
+        }
+        memcpy(name, part, part_len);
+        name[part_len] = 0;
+        const dir_index *index = get_index(path);
+        const char *actual = index ? find_in_index(index, name) : 0;
+        size_t actual_len = actual ? strlen(actual) : 0;
+        if (!actual || path_len + actual_len + 2 > sizeof(path)) {
+            found = 0;
+            break;
+        }
+        if (path_len) {
+            path[path_len++] = '/';
         }
+        memcpy(&path[path_len], actual, actual_len + 1);
+        path_len += actual_len;
+        part += part_len;
     }
-    return 0;
+    unlock_indexes();
+    if (found && path_len > dir_len) {
+        memcpy(corrected_filename, path, path_len + 1);
+        return corrected_filename;
+    }
+    // The file may have been created after its directory was indexed
+    return file_if_exists(corrected_filename);
 }
 
 const char *dir_get_file(const char *filepath, int localizable)
@@ -171,3 +344,24 @@ const char *dir_get_file(const char *filepath, int localizable)
 
     return get_case_corrected_file(0, filepath);
 }
+
+void dir_invalidate_index(const char *filepath)
+{
+    lock_indexes();
+    int dir_len = 0;
+    for (int i = 0; filepath && filepath[i]; i++) {
+        if (is_separator(filepath[i])) {
+            dir_len = i;
+        }
+    }
+    for (int i = 0; i < indexes.num_items; i++) {
+        const char *path = indexes.items[i]->path;
+        if (!filepath || ((int) strlen(path) == dir_len &&
+            platform_file_manager_compare_filename_prefix(path, filepath, dir_len) == 0)) {
+            free_index(indexes.items[i]);
+            indexes.items[i] = indexes.items[--indexes.num_items];
+            i--;
+        }
+    }
+    unlock_indexes();
+}
@@ -27,6 +27,14 @@ typedef struct {
  */
 const dir_listing *dir_find_files_with_extension(const char *extension);
 
+/**
+ * Finds files with any of the given extensions, in one sorted listing
+ * @param extensions Extensions of the files to find
+ * @param num_extensions Number of extensions
+ * @return Directory listing
+ */
+const dir_listing *dir_find_files_with_extensions(const char *const *extensions, int num_extensions);
+
 /**
  * Finds all subdirectories
  * @return Directory listing
@@ -41,4 +49,11 @@ const dir_listing *dir_find_all_subdirectories(void);
  */
 const char *dir_get_file(const char *filepath, int localizable);
 
+/**
+ * Forgets the indexed names of the directory of a file, after the file was created or removed.
+ * Directories are indexed on first use so that case-insensitive lookups don't have to list them again.
+ * @param filepath Path of the file that changed, or NULL to forget all directories
+ */
+void dir_invalidate_index(const char *filepath);
+
 #endif // CORE_DIR_H
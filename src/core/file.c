@@ -1,14 +1,20 @@
 #include "core/file.h"
 
+#include "core/dir.h"
 #include "core/string.h"
 #include "platform/file_manager.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 FILE *file_open(const char *filename, const char *mode)
 {
-    return platform_file_manager_open_file(filename, mode);
+    FILE *fp = platform_file_manager_open_file(filename, mode);
+    if (fp && (strchr(mode, 'w') || strchr(mode, 'a'))) {
+        dir_invalidate_index(filename);
+    }
+    return fp;
 }
 
 int file_close(FILE *stream)
@@ -82,5 +88,7 @@ int file_exists(const char *filename, int localizable)
 
 int file_remove(const char *filename)
 {
-    return platform_file_manager_remove_file(filename);
+    int result = platform_file_manager_remove_file(filename);
+    dir_invalidate_index(filename);
+    return result;
 }
@@ -0,0 +1,15 @@
+#include "core/hash.h"
+
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ULL
+#define FNV_PRIME 0x100000001b3ULL
+
+uint64_t hash_data(const void *data, int length)
+{
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (int i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
@@ -0,0 +1,19 @@
+#ifndef CORE_HASH_H
+#define CORE_HASH_H
+
+#include <stdint.h>
+
+/**
+ * @file
+ * Hash functions.
+ */
+
+/**
+ * Calculates the 64-bit FNV-1a hash of a block of data
+ * @param data Data to hash
+ * @param length Length of the data in bytes
+ * @return Hash value
+ */
+uint64_t hash_data(const void *data, int length);
+
+#endif // CORE_HASH_H
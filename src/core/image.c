@@ -210,9 +210,7 @@ static void read_index(buffer *buf, image *images, int size)
 static void read_header(buffer *buf)
 {
     buffer_skip(buf, 80); // header integers
-    for (int i = 0; i < 300; i++) {
-        data.group_image_ids[i] = buffer_read_u16(buf);
-    }
+    buffer_read_u16_array(buf, data.group_image_ids, 300);
     buffer_read_raw(buf, data.bitmaps, 20000);
 }
 
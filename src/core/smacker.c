@@ -93,6 +93,9 @@ struct smacker_t {
 
     frame_data_t frame_data;
     int32_t current_frame;
+
+    uint8_t *read_buffer;
+    int32_t max_frame_size;
 };
 
 static const uint8_t BIT_MASKS[] = {
@@ -467,6 +470,9 @@ static int read_frame_info(smacker s)
         s->frame_sizes[i] = read_i32(&data[4 * i]) & 0xfffffffc;
         s->frame_offsets[i] = offset;
         offset += s->frame_sizes[i];
+        if (s->frame_sizes[i] > s->max_frame_size) {
+            s->max_frame_size = s->frame_sizes[i];
+        }
     }
     return 1;
 }
@@ -495,6 +501,12 @@ static int allocate_frame_memory(smacker s)
         log_error("SMK: no memory for video frame", 0, 0);
         return 0;
     }
+    // Frame data is read into the same buffer for every frame
+    s->read_buffer = clear_malloc(sizeof(uint8_t) * s->max_frame_size);
+    if (!s->read_buffer && s->max_frame_size) {
+        log_error("SMK: no memory for frame data", 0, 0);
+        return 0;
+    }
     for (int i = 0; i < MAX_TRACKS; i++) {
         if (s->audio_rate[i] & AUDIO_FLAG_HAS_TRACK) {
             s->frame_data.audio[i] = clear_malloc(s->audio_size[i]);
@@ -551,6 +563,7 @@ void smacker_close(smacker s)
         free(s->frame_data.audio[i]);
     }
     free(s->frame_data.video);
+    free(s->read_buffer);
     free(s);
 }
 
@@ -811,22 +824,11 @@ static uint8_t *read_frame_data(smacker s, int frame_id)
         return NULL;
     }
     int frame_size = s->frame_sizes[frame_id];
-    uint8_t *frame_data = (uint8_t *) clear_malloc(frame_size);
-    if (!frame_data) {
-        log_error("SMK: no memory for frame data", 0, frame_id);
-        return NULL;
-    }
-    if (fread(frame_data, 1, frame_size, s->fp) != frame_size) {
+    if (fread(s->read_buffer, 1, frame_size, s->fp) != frame_size) {
         log_error("SMK: unable to read data for frame", 0, frame_id);
-        free(frame_data);
         return NULL;
     }
-    return frame_data;
-}
-
-static void free_frame_data(const smacker s, uint8_t *frame_data)
-{
-    free(frame_data);
+    return s->read_buffer;
 }
 
 static smacker_frame_status decode_frame(smacker s)
@@ -846,7 +848,6 @@ static smacker_frame_status decode_frame(smacker s)
     if (frame_type & 0x01) {
         int palette_size = frame_data[0] * 4;
         if (!decode_palette(s, &frame_data[1], palette_size - 1)) {
-            free_frame_data(s, frame_data);
             return SMACKER_FRAME_ERROR;
         }
         data_index += palette_size;
@@ -861,11 +862,8 @@ static smacker_frame_status decode_frame(smacker s)
         }
     }
     if (!decode_video(s, &frame_data[data_index], s->frame_sizes[frame_id] - data_index)) {
-        free_frame_data(s, frame_data);
         return SMACKER_FRAME_ERROR;
     }
-
-    free_frame_data(s, frame_data);
     return SMACKER_FRAME_OK;
 }
 
@@ -0,0 +1,70 @@
+#ifndef CORE_THREAD_H
+#define CORE_THREAD_H
+
+/**
+ * @file
+ * Threading primitives, implemented by the underlying system.
+ * All create functions may return 0 when threads are not supported:
+ * callers must then fall back to doing the work on the calling thread.
+ */
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL
+#define THREAD_NO_LOCAL_STORAGE
+#endif
+
+typedef struct thread thread;
+typedef struct thread_mutex thread_mutex;
+typedef struct thread_condition thread_condition;
+
+/**
+ * Gets the number of logical CPU cores
+ * @return Number of cores, at least 1
+ */
+int thread_cpu_count(void);
+
+/**
+ * Starts a new thread
+ * @param func Function to run on the thread
+ * @param name Name of the thread, for debugging
+ * @param data Data to pass to the function
+ * @return Thread handle, or 0 if the thread could not be created
+ */
+thread *thread_create(int (*func)(void *), const char *name, void *data);
+
+/**
+ * Waits for a thread to finish and releases its resources
+ * @param t Thread to wait for
+ */
+void thread_wait(thread *t);
+
+/**
+ * Creates a mutex
+ * @return Mutex, or 0 if it could not be created
+ */
+thread_mutex *thread_mutex_create(void);
+void thread_mutex_destroy(thread_mutex *mutex);
+void thread_mutex_lock(thread_mutex *mutex);
+void thread_mutex_unlock(thread_mutex *mutex);
+
+/**
+ * Creates a condition variable
+ * @return Condition, or 0 if it could not be created
+ */
+thread_condition *thread_condition_create(void);
+void thread_condition_destroy(thread_condition *condition);
+
+/**
+ * Waits on a condition. The mutex must be locked and is locked again on return.
+ * @param condition Condition to wait for
+ * @param mutex Locked mutex protecting the condition
+ */
+void thread_condition_wait(thread_condition *condition, thread_mutex *mutex);
+void thread_condition_signal(thread_condition *condition);
+void thread_condition_broadcast(thread_condition *condition);
+
+#endif // CORE_THREAD_H
@@ -0,0 +1,182 @@
+#include "thread_pool.h"
+
+#include "core/log.h"
+#include "core/thread.h"
+
+#define MAX_WORKERS 15
+
+static struct {
+    thread *workers[MAX_WORKERS];
+    int num_workers;
+    thread_mutex *mutex;
+    thread_condition *work_available;
+    thread_condition *work_done;
+    int quit;
+    int running;
+    struct {
+        void (*func)(int index, void *data);
+        void *data;
+        int num_tasks;
+        int next_task;
+        int tasks_done;
+    } job;
+} pool;
+
+static void run_tasks_locked(void)
+{
+    while (pool.job.next_task < pool.job.num_tasks) {
+        int index = pool.job.next_task++;
+        thread_mutex_unlock(pool.mutex);
+        pool.job.func(index, pool.job.data);
+        thread_mutex_lock(pool.mutex);
+        pool.job.tasks_done++;
+        if (pool.job.tasks_done == pool.job.num_tasks) {
+            thread_condition_signal(pool.work_done);
+        }
+    }
+}
+
+static int worker_loop(void *unused)
+{
+    thread_mutex_lock(pool.mutex);
+    while (!pool.quit) {
+        if (pool.job.next_task < pool.job.num_tasks) {
+            run_tasks_locked();
+        } else {
+            thread_condition_wait(pool.work_available, pool.mutex);
+        }
+    }
+    thread_mutex_unlock(pool.mutex);
+    return 0;
+}
+
+static void destroy_sync_objects(void)
+{
+    if (pool.work_done) {
+        thread_condition_destroy(pool.work_done);
+        pool.work_done = 0;
+    }
+    if (pool.work_available) {
+        thread_condition_destroy(pool.work_available);
+        pool.work_available = 0;
+    }
+    if (pool.mutex) {
+        thread_mutex_destroy(pool.mutex);
+        pool.mutex = 0;
+    }
+}
+
+void thread_pool_init(int num_threads)
+{
+    thread_pool_shutdown();
+    if (num_threads <= 0) {
+        num_threads = thread_cpu_count();
+    }
+    int num_workers = num_threads - 1;
+    if (num_workers > MAX_WORKERS) {
+        num_workers = MAX_WORKERS;
+    }
+    if (num_workers <= 0) {
+        return;
+    }
+    pool.mutex = thread_mutex_create();
+    pool.work_available = thread_condition_create();
+    pool.work_done = thread_condition_create();
+    if (!pool.mutex || !pool.work_available || !pool.work_done) {
+        destroy_sync_objects();
+        return;
+    }
+    pool.quit = 0;
+    pool.job.num_tasks = 0;
+    pool.job.next_task = 0;
+    for (int i = 0; i < num_workers; i++) {
+        pool.workers[i] = thread_create(worker_loop, "worker", 0);
+        if (!pool.workers[i]) {
+            break;
+        }
+        pool.num_workers++;
+    }
+    if (!pool.num_workers) {
+        destroy_sync_objects();
+        return;
+    }
+    log_info("Worker threads started:", 0, pool.num_workers);
+}
+
+void thread_pool_shutdown(void)
+{
+    if (!pool.num_workers) {
+        return;
+    }
+    thread_mutex_lock(pool.mutex);
+    pool.quit = 1;
+    thread_condition_broadcast(pool.work_available);
+    thread_mutex_unlock(pool.mutex);
+    for (int i = 0; i < pool.num_workers; i++) {
+        thread_wait(pool.workers[i]);
+        pool.workers[i] = 0;
+    }
+    pool.num_workers = 0;
+    destroy_sync_objects();
+}
+
+int thread_pool_num_threads(void)
+{
+    return pool.num_workers + 1;
+}
+
+void thread_pool_run(void (*func)(int index, void *data), int num_tasks, void *data)
+{
+    if (!pool.num_workers || pool.running || num_tasks <= 1) {
+        for (int i = 0; i < num_tasks; i++) {
+            func(i, data);
+        }
+        return;
+    }
+    pool.running = 1;
+    thread_mutex_lock(pool.mutex);
+    pool.job.func = func;
+    pool.job.data = data;
+    pool.job.num_tasks = num_tasks;
+    pool.job.next_task = 0;
+    pool.job.tasks_done = 0;
+    thread_condition_broadcast(pool.work_available);
+    run_tasks_locked();
+    while (pool.job.tasks_done < pool.job.num_tasks) {
+        thread_condition_wait(pool.work_done, pool.mutex);
+    }
+    thread_mutex_unlock(pool.mutex);
+    pool.running = 0;
+}
+
+typedef struct {
+    void (*func)(int start, int end, void *data);
+    void *data;
+    int total;
+    int range_size;
+} range_job;
+
+static void run_range(int index, void *data)
+{
+    const range_job *job = data;
+    int start = index * job->range_size;
+    int end = start + job->range_size;
+    if (end > job->total) {
+        end = job->total;
+    }
+    job->func(start, end, job->data);
+}
+
+void thread_pool_run_ranges(void (*func)(int start, int end, void *data), int total, int min_range_size, void *data)
+{
+    if (total <= 0) {
+        return;
+    }
+    int num_ranges = 2 * thread_pool_num_threads();
+    range_job job = {func, data, total, (total + num_ranges - 1) / num_ranges};
+    if (job.range_size < min_range_size) {
+        job.range_size = min_range_size;
+    }
+    num_ranges = (total + job.range_size - 1) / job.range_size;
+    thread_pool_run(run_range, num_ranges, &job);
+}
@@ -0,0 +1,49 @@
+#ifndef CORE_THREAD_POOL_H
+#define CORE_THREAD_POOL_H
+
+/**
+ * @file
+ * Fixed-size pool of worker threads for running independent tasks in parallel.
+ * When no worker threads are available, tasks run on the calling thread.
+ */
+
+/**
+ * Starts the worker threads
+ * @param num_threads Total number of threads to use, including the calling thread.
+ *        Use 0 to base it on the number of CPU cores.
+ */
+void thread_pool_init(int num_threads);
+
+/**
+ * Stops all worker threads
+ */
+void thread_pool_shutdown(void);
+
+/**
+ * Gets the number of threads that run tasks, including the calling thread
+ * @return Number of threads, at least 1
+ */
+int thread_pool_num_threads(void);
+
+/**
+ * Runs a number of tasks on the pool and waits until all of them are done.
+ * The calling thread also runs tasks. Tasks are started in order of their index,
+ * but may finish in any order. Calls from within a task run serially.
+ * @param func Function to call for each task
+ * @param num_tasks Number of tasks: func is called with index 0 to num_tasks - 1
+ * @param data Data to pass to each task
+ */
+void thread_pool_run(void (*func)(int index, void *data), int num_tasks, void *data);
+
+/**
+ * Splits the range 0 to total - 1 into consecutive parts and runs them as tasks on the pool.
+ * When each part only writes its own outputs, the result is the same as calling func once
+ * for the whole range.
+ * @param func Function to call for each part, with the part's start and (exclusive) end
+ * @param total Size of the range
+ * @param min_range_size Minimum size of a part, to keep small jobs on fewer threads
+ * @param data Data to pass to each task
+ */
+void thread_pool_run_ranges(void (*func)(int start, int end, void *data), int total, int min_range_size, void *data);
+
+#endif // CORE_THREAD_POOL_H
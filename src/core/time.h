@@ -1,6 +1,8 @@
 #ifndef CORE_TIME_H
 #define CORE_TIME_H
 
+#include <stdint.h>
+
 /**
  * @file
  * Time tracking functions.
@@ -23,4 +25,11 @@ time_millis time_get_millis(void);
  */
 void time_set_millis(time_millis millis);
 
+/**
+ * Gets the time of a high-resolution clock, independent of the game time above.
+ * Use only for measuring durations.
+ * @return Time in microseconds
+ */
+uint64_t time_get_micros(void);
+
 #endif // CORE_TIME_H
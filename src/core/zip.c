@@ -12,10 +12,16 @@ enum {
     PK_LITERAL_ENCODING_UNSUPPORTED = 2,
     PK_TOO_FEW_INPUT_BYTES = 3,
     PK_ERROR_DECODING = 4,
-    PK_ERROR_VALUE = 774,
+    PK_OUT_OF_SPACE = 5,
     PK_EOF = 773,
 };
 
+#define PK_MAX_COPY_LENGTH 516
+#define PK_CHAIN_DICTIONARY_SIZE 4096
+#define PK_CHAIN_WINDOW_SIZE 6
+#define PK_CHAIN_MAX_DISTANCE (PK_CHAIN_DICTIONARY_SIZE - 1)
+#define PK_CHAIN_HASH_SIZE 0x10000
+
 struct pk_token {
     int stop;
 
@@ -53,24 +59,29 @@ struct pk_comp_buffer {
     uint8_t codeword_bits[774];
 };
 
+struct pk_explode_code {
+    uint16_t value; // literal byte, or 256 + base value of the copy length token
+    uint8_t bits;
+    uint8_t extra_bits;
+};
+
+struct pk_explode_offset_code {
+    uint8_t bits;
+    uint8_t value;
+};
+
 struct pk_decomp_buffer {
-    pk_input_func *input_func;
-    pk_output_func *output_func;
-    struct pk_token *token;
+    const uint8_t *input;
+    const uint8_t *input_end;
+    uint64_t bit_buffer;
+    int bits_in_buffer;
 
     int window_size;
-    int dictionary_size;
-    uint16_t current_input_byte;
-    int current_input_bits_available;
 
-    int input_buffer_ptr;
-    int input_buffer_end;
-    int output_buffer_ptr;
-    uint8_t input_buffer[2048];
-    uint8_t output_buffer[8708]; // 2x 4096 (max dict size) + 516 for copying
-
-    uint8_t copy_offset_jump_table[256];
-    uint8_t copy_length_jump_table[256];
+    // indexed by the next 9 bits: a literal token or the copy length code
+    struct pk_explode_code codes[512];
+    // indexed by the next 8 bits: the high bits of a copy offset
+    struct pk_explode_offset_code offset_codes[256];
 };
 
 struct pk_copy_length_offset {
@@ -78,6 +89,25 @@ struct pk_copy_length_offset {
     uint16_t offset;
 };
 
+struct pk_chain_buffer {
+    // most recent position for each pair of bytes, and the previous position with the same pair
+    int head[PK_CHAIN_HASH_SIZE];
+    int prev[PK_CHAIN_DICTIONARY_SIZE];
+
+    int max_chain_length;
+    int good_length;
+
+    uint8_t *output_data;
+    int output_length;
+    int output_ptr;
+    uint32_t bit_buffer;
+    int bits_in_buffer;
+    int error;
+
+    uint16_t codeword_values[774];
+    uint8_t codeword_bits[774];
+};
+
 static const uint8_t pk_copy_offset_bits[64] = {
     2, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 6, 6, 6, 6, 6,
     6, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
@@ -466,6 +496,28 @@ static void pk_implode_data(struct pk_comp_buffer *buf)
     buf->output_func(buf->output_data, buf->output_ptr, buf->token);
 }
 
+static void pk_implode_init_codewords(uint16_t *codeword_values, uint8_t *codeword_bits)
+{
+    for (int i = 0; i < 256; i++) {
+        codeword_bits[i] = 9; // 8 + 1 for leading zero
+        codeword_values[i] = (uint16_t) (i << 1); // include leading zero to indicate literal byte
+    }
+
+    // prepare copy length values right after the literal bits
+    int code_index = 256;
+    for (int copy = 0; copy < 16; copy++) {
+        int base_bits = pk_copy_length_base_bits[copy];
+        int extra_bits = pk_copy_length_extra_bits[copy];
+        int base_code = pk_copy_length_base_code[copy];
+        int max = 1 << extra_bits;
+        for (int i = 0; i < max; i++) {
+            codeword_bits[code_index] = (uint8_t) (1 + base_bits + extra_bits);
+            codeword_values[code_index] = (uint16_t) (1 | (base_code << 1) | (i << (base_bits + 1)));
+            code_index++;
+        }
+    }
+}
+
 static int pk_implode(pk_input_func *input_func, pk_output_func *output_func,
                       struct pk_comp_buffer *buf, struct pk_token *token, int dictionary_size)
 {
@@ -486,200 +538,293 @@ static int pk_implode(pk_input_func *input_func, pk_output_func *output_func,
         return PK_INVALID_WINDOWSIZE;
     }
 
-    for (int i = 0; i < 256; i++) {
-        buf->codeword_bits[i] = 9; // 8 + 1 for leading zero
-        buf->codeword_values[i] = (uint16_t) (i << 1); // include leading zero to indicate literal byte
-    }
+    pk_implode_init_codewords(buf->codeword_values, buf->codeword_bits);
+    pk_implode_data(buf);
+    return PK_SUCCESS;
+}
 
-    // prepare copy length values right after the literal bits
-    int code_index = 256;
-    for (int copy = 0; copy < 16; copy++) {
-        int base_bits = pk_copy_length_base_bits[copy];
-        int extra_bits = pk_copy_length_extra_bits[copy];
-        int base_code = pk_copy_length_base_code[copy];
-        int max = 1 << extra_bits;
-        for (int i = 0; i < max; i++) {
-            buf->codeword_bits[code_index] = (uint8_t) (1 + base_bits + extra_bits);
-            buf->codeword_values[code_index] = (uint16_t) (1 | (base_code << 1) | (i << (base_bits + 1)));
-            code_index++;
+static void pk_chain_write_bits(struct pk_chain_buffer *buf, int num_bits, unsigned int value)
+{
+    buf->bit_buffer |= value << buf->bits_in_buffer;
+    buf->bits_in_buffer += num_bits;
+    while (buf->bits_in_buffer >= 8) {
+        if (buf->output_ptr >= buf->output_length) {
+            buf->error = 1;
+            return;
         }
+        buf->output_data[buf->output_ptr++] = (uint8_t) buf->bit_buffer;
+        buf->bit_buffer >>= 8;
+        buf->bits_in_buffer -= 8;
     }
+}
 
-    pk_implode_data(buf);
-    return PK_SUCCESS;
+static void pk_chain_write_copy(struct pk_chain_buffer *buf, int length, int distance)
+{
+    int offset = distance - 1;
+    pk_chain_write_bits(buf, buf->codeword_bits[length + 254], buf->codeword_values[length + 254]);
+    if (length == 2) {
+        pk_chain_write_bits(buf, pk_copy_offset_bits[offset >> 2], pk_copy_offset_code[offset >> 2]);
+        pk_chain_write_bits(buf, 2, offset & 3);
+    } else {
+        pk_chain_write_bits(buf, pk_copy_offset_bits[offset >> PK_CHAIN_WINDOW_SIZE],
+            pk_copy_offset_code[offset >> PK_CHAIN_WINDOW_SIZE]);
+        pk_chain_write_bits(buf, PK_CHAIN_WINDOW_SIZE, offset & (PK_CHAIN_DICTIONARY_SIZE / 64 - 1));
+    }
 }
 
-static void pk_explode_construct_jump_table(int size, const uint8_t *bits, const uint8_t *codes, uint8_t *jump)
+static void pk_chain_insert(struct pk_chain_buffer *buf, const uint8_t *input, int position, int input_length)
 {
-    for (int i = size - 1; i >= 0; i--) {
-        uint8_t bit = bits[i];
-        int code = codes[i];
-        do {
-            jump[code] = (uint8_t) i;
-            code += 1 << bit;
-        } while (code < 0x100);
+    if (position + 1 < input_length) {
+        int hash = input[position] | (input[position + 1] << 8);
+        buf->prev[position & (PK_CHAIN_DICTIONARY_SIZE - 1)] = buf->head[hash];
+        buf->head[hash] = position;
     }
 }
 
-static int pk_explode_set_bits_used(struct pk_decomp_buffer *buf, int num_bits)
+static int pk_chain_find_copy(struct pk_chain_buffer *buf, const uint8_t *input, int position, int input_length,
+    int *distance)
 {
-    if (buf->current_input_bits_available >= num_bits) {
-        buf->current_input_bits_available -= num_bits;
-        buf->current_input_byte = (uint16_t) (buf->current_input_byte >> num_bits);
+    int max_length = input_length - position;
+    if (max_length < 2) {
         return 0;
     }
-    buf->current_input_byte = (uint16_t) (buf->current_input_byte >> buf->current_input_bits_available);
-    if (buf->input_buffer_ptr == buf->input_buffer_end) {
-        // Fill buffer
-        buf->input_buffer_ptr = 2048;
-        buf->input_buffer_end = buf->input_func(buf->input_buffer, buf->input_buffer_ptr, buf->token);
-        if (!buf->input_buffer_end) {
-            return 1;
+    if (max_length > PK_MAX_COPY_LENGTH) {
+        max_length = PK_MAX_COPY_LENGTH;
+    }
+    const uint8_t *current = &input[position];
+    int best_length = 1;
+    int chain_length = buf->max_chain_length;
+    int candidate = buf->head[current[0] | (current[1] << 8)];
+    while (candidate >= 0 && position - candidate <= PK_CHAIN_MAX_DISTANCE && chain_length-- > 0) {
+        const uint8_t *match = &input[candidate];
+        // the pair of bytes is known to match: check the byte that would make this copy longer first
+        if (match[best_length] == current[best_length] || best_length == 1) {
+            int length = 2;
+            while (length < max_length && match[length] == current[length]) {
+                length++;
+            }
+            if (length > best_length) {
+                best_length = length;
+                *distance = position - candidate;
+                if (length >= max_length) {
+                    break;
+                }
+            }
         }
-        buf->input_buffer_ptr = 0;
+        candidate = buf->prev[candidate & (PK_CHAIN_DICTIONARY_SIZE - 1)];
     }
+    if (best_length < 2) {
+        return 0;
+    }
+    if (best_length == 2 && *distance > 256) {
+        // short copies can only reach back 256 bytes
+        return 0;
+    }
+    return best_length;
+}
 
-    buf->current_input_byte |= (uint16_t) (buf->input_buffer[buf->input_buffer_ptr++] << 8);
-    buf->current_input_byte = (uint16_t) (buf->current_input_byte >> (num_bits - buf->current_input_bits_available));
-    buf->current_input_bits_available += 8 - num_bits;
-    return 0;
+static int pk_chain_next_copy_is_better(int length, int distance, int next_length)
+{
+    // same trade-off as the original encoder
+    if (length >= next_length) {
+        return 0;
+    }
+    if (length + 1 == next_length && distance <= 129) {
+        return 0;
+    }
+    return 1;
 }
 
-static int pk_explode_decode_next_token(struct pk_decomp_buffer *buf)
+static void pk_implode_chained(struct pk_chain_buffer *buf, const uint8_t *input, int input_length)
 {
-    if (buf->current_input_byte & 1) {
-        // copy
-        if (pk_explode_set_bits_used(buf, 1)) {
-            return PK_ERROR_VALUE;
-        }
-        int index = buf->copy_length_jump_table[buf->current_input_byte & 0xff];
-        if (pk_explode_set_bits_used(buf, pk_copy_length_base_bits[index])) {
-            return PK_ERROR_VALUE;
-        }
-        int extra_bits = pk_copy_length_extra_bits[index];
-        if (extra_bits) {
-            int extra_bits_value = buf->current_input_byte & ((1 << extra_bits) - 1);
-            if (pk_explode_set_bits_used(buf, extra_bits) && index + extra_bits_value != 270) {
-                return PK_ERROR_VALUE;
+    memset(buf->head, 0xff, sizeof(buf->head));
+    pk_implode_init_codewords(buf->codeword_values, buf->codeword_bits);
+
+    pk_chain_write_bits(buf, 8, 0); // no literal encoding
+    pk_chain_write_bits(buf, 8, PK_CHAIN_WINDOW_SIZE);
+
+    int position = 0;
+    int distance = 0;
+    int length = pk_chain_find_copy(buf, input, position, input_length, &distance);
+    while (position < input_length && !buf->error) {
+        pk_chain_insert(buf, input, position, input_length);
+        int next_distance = 0;
+        int next_length = 0;
+        if (length >= 2 && length < buf->good_length) {
+            next_length = pk_chain_find_copy(buf, input, position + 1, input_length, &next_distance);
+            if (pk_chain_next_copy_is_better(length, distance, next_length)) {
+                length = 0;
             }
-            index = pk_copy_length_base_value[index] + extra_bits_value;
-        }
-        return index + 256;
-    } else {
-        // literal token
-        if (pk_explode_set_bits_used(buf, 1)) {
-            return PK_ERROR_VALUE;
         }
-        int result = buf->current_input_byte & 0xff;
-        if (pk_explode_set_bits_used(buf, 8)) {
-            return PK_ERROR_VALUE;
+        if (length >= 2) {
+            pk_chain_write_copy(buf, length, distance);
+            for (int i = 1; i < length; i++) {
+                pk_chain_insert(buf, input, position + i, input_length);
+            }
+            position += length;
+            length = pk_chain_find_copy(buf, input, position, input_length, &distance);
+        } else {
+            pk_chain_write_bits(buf, buf->codeword_bits[input[position]], buf->codeword_values[input[position]]);
+            position++;
+            if (next_length) {
+                length = next_length;
+                distance = next_distance;
+            } else {
+                length = pk_chain_find_copy(buf, input, position, input_length, &distance);
+            }
         }
-        return result;
+    }
+
+    pk_chain_write_bits(buf, buf->codeword_bits[PK_EOF], buf->codeword_values[PK_EOF]);
+    if (buf->bits_in_buffer) {
+        pk_chain_write_bits(buf, 8 - buf->bits_in_buffer, 0);
     }
 }
 
-static int pk_explode_get_copy_offset(struct pk_decomp_buffer *buf, int copy_length)
+static void pk_explode_construct_jump_table(int size, const uint8_t *bits, const uint8_t *codes, uint8_t *jump)
 {
-    int index = buf->copy_offset_jump_table[buf->current_input_byte & 0xff];
-    if (pk_explode_set_bits_used(buf, pk_copy_offset_bits[index])) {
-        return 0;
+    for (int i = size - 1; i >= 0; i--) {
+        uint8_t bit = bits[i];
+        int code = codes[i];
+        do {
+            jump[code] = (uint8_t) i;
+            code += 1 << bit;
+        } while (code < 0x100);
     }
-    int offset;
-    if (copy_length == 2) {
-        offset = (buf->current_input_byte & 3) | (index << 2);
-        if (pk_explode_set_bits_used(buf, 2)) {
-            return 0;
+}
+
+static void pk_explode_init_tables(struct pk_decomp_buffer *buf)
+{
+    uint8_t length_jump_table[256];
+    uint8_t offset_jump_table[256];
+    pk_explode_construct_jump_table(16, pk_copy_length_base_bits, pk_copy_length_base_code, length_jump_table);
+    pk_explode_construct_jump_table(64, pk_copy_offset_bits, pk_copy_offset_code, offset_jump_table);
+
+    for (int i = 0; i < 512; i++) {
+        struct pk_explode_code *code = &buf->codes[i];
+        if (i & 1) {
+            int index = length_jump_table[i >> 1];
+            code->value = (uint16_t) (256 + pk_copy_length_base_value[index]);
+            code->bits = (uint8_t) (1 + pk_copy_length_base_bits[index]);
+            code->extra_bits = pk_copy_length_extra_bits[index];
+        } else {
+            code->value = (uint16_t) (i >> 1);
+            code->bits = 9;
+            code->extra_bits = 0;
         }
+    }
+    for (int i = 0; i < 256; i++) {
+        buf->offset_codes[i].value = offset_jump_table[i];
+        buf->offset_codes[i].bits = pk_copy_offset_bits[offset_jump_table[i]];
+    }
+}
+
+static void pk_explode_refill(struct pk_decomp_buffer *buf)
+{
+    if (buf->input_end - buf->input >= 8) {
+        const uint8_t *in = buf->input;
+        uint64_t value = (uint64_t) in[0] | ((uint64_t) in[1] << 8) | ((uint64_t) in[2] << 16) |
+            ((uint64_t) in[3] << 24) | ((uint64_t) in[4] << 32) | ((uint64_t) in[5] << 40) |
+            ((uint64_t) in[6] << 48) | ((uint64_t) in[7] << 56);
+        buf->bit_buffer |= value << buf->bits_in_buffer;
+        int bytes = (63 - buf->bits_in_buffer) >> 3;
+        buf->input += bytes;
+        buf->bits_in_buffer += bytes * 8;
     } else {
-        offset = (buf->current_input_byte & buf->dictionary_size) | (index << buf->window_size);
-        if (pk_explode_set_bits_used(buf, buf->window_size)) {
-            return 0;
+        while (buf->bits_in_buffer <= 56 && buf->input < buf->input_end) {
+            buf->bit_buffer |= (uint64_t) *buf->input++ << buf->bits_in_buffer;
+            buf->bits_in_buffer += 8;
         }
     }
-    return offset + 1;
 }
 
-static int pk_explode_data(struct pk_decomp_buffer *buf)
+static void pk_explode_consume_bits(struct pk_decomp_buffer *buf, int num_bits)
 {
-    int token;
-    buf->output_buffer_ptr = 4096;
-    while (1) {
-        token = pk_explode_decode_next_token(buf);
-        if (token >= PK_ERROR_VALUE - 1) {
-            break;
-        }
-        if (token >= 256) {
-            // copy offset
-            int length = token - 254;
-            int offset = pk_explode_get_copy_offset(buf, length);
-            if (!offset) {
-                token = PK_ERROR_VALUE;
-                break;
-            }
-            uint8_t *src = &buf->output_buffer[buf->output_buffer_ptr - offset];
-            uint8_t *dst = &buf->output_buffer[buf->output_buffer_ptr];
-            buf->output_buffer_ptr += length;
-            do {
-                *dst = *src;
-                src++;
-                dst++;
-            } while (--length > 0);
-        } else {
-            // literal byte
-            buf->output_buffer[buf->output_buffer_ptr++] = (uint8_t) token;
+    buf->bit_buffer >>= num_bits;
+    buf->bits_in_buffer -= num_bits;
+}
+
+static void pk_explode_copy(uint8_t *output, uint8_t *out, int length, int offset)
+{
+    int position = (int) (out - output) - offset;
+    if (position < 0) {
+        // the dictionary starts out filled with zeros
+        for (int i = 0; i < length; i++, position++) {
+            out[i] = position >= 0 ? output[position] : 0;
         }
-        if (buf->output_buffer_ptr >= 8192) {
-            // Flush buffer
-            buf->output_func(&buf->output_buffer[4096], 4096, buf->token);
-            pk_memcpy(buf->output_buffer, &buf->output_buffer[4096], buf->output_buffer_ptr - 4096);
-            buf->output_buffer_ptr -= 4096;
+    } else if (offset >= length) {
+        memcpy(out, out - offset, (size_t) length);
+    } else if (offset == 1) {
+        memset(out, out[-1], (size_t) length);
+    } else {
+        // overlapping copy: every block of offset bytes repeats the previous one
+        while (length > 0) {
+            int block = length < offset ? length : offset;
+            memcpy(out, out - offset, (size_t) block);
+            out += block;
+            length -= block;
         }
     }
-    int remaining_bytes = buf->output_buffer_ptr - 4096;
-    if (remaining_bytes > 0) {
-        // Flush buffer if needed
-        buf->output_func(&buf->output_buffer[4096], remaining_bytes, buf->token);
-    }
-    return token;
 }
 
-static int pk_explode(pk_input_func *input_func, pk_output_func *output_func,
-                      struct pk_decomp_buffer *buf, struct pk_token *token)
+static int pk_explode(struct pk_decomp_buffer *buf, const uint8_t *input, int input_length,
+                      uint8_t *output, int *output_length)
 {
-    buf->input_func = input_func;
-    buf->output_func = output_func;
-    buf->token = token;
-    buf->input_buffer_ptr = 2048;
-    int bytes_read = buf->input_func(buf->input_buffer, buf->input_buffer_ptr, buf->token);
-    buf->input_buffer_end = bytes_read;
-    if (bytes_read <= 4) {
+    if (input_length <= 4) {
         return PK_TOO_FEW_INPUT_BYTES;
     }
-    int has_literal_encoding = buf->input_buffer[0];
-    buf->window_size = buf->input_buffer[1];
-    buf->current_input_byte = buf->input_buffer[2];
-    buf->current_input_bits_available = 0;
-    buf->input_buffer_ptr = 3;
-
+    int has_literal_encoding = input[0];
+    buf->window_size = input[1];
     if (buf->window_size < 4 || buf->window_size > 6) {
         return PK_INVALID_WINDOWSIZE;
     }
-
-    buf->dictionary_size = 0xFFFF >> (16 - buf->window_size);
     if (has_literal_encoding) {
         return PK_LITERAL_ENCODING_UNSUPPORTED;
     }
+    pk_explode_init_tables(buf);
+    buf->input = &input[2];
+    buf->input_end = &input[input_length];
+    buf->bit_buffer = 0;
+    buf->bits_in_buffer = 0;
 
-    // Decode data for copying bytes
-    pk_explode_construct_jump_table(16,
-        pk_copy_length_base_bits, pk_copy_length_base_code, buf->copy_length_jump_table);
-    pk_explode_construct_jump_table(64,
-        pk_copy_offset_bits, pk_copy_offset_code, buf->copy_offset_jump_table);
-
-    int result = pk_explode_data(buf);
-    if (result != PK_EOF) {
-        return PK_ERROR_DECODING;
+    uint8_t *out = output;
+    uint8_t *out_end = output + *output_length;
+    while (1) {
+        pk_explode_refill(buf);
+        const struct pk_explode_code *code = &buf->codes[buf->bit_buffer & 0x1ff];
+        int token_bits = code->bits + code->extra_bits;
+        if (token_bits > buf->bits_in_buffer) {
+            return PK_ERROR_DECODING;
+        }
+        if (code->value < 256) {
+            if (out == out_end) {
+                return PK_OUT_OF_SPACE;
+            }
+            *out++ = (uint8_t) code->value;
+            pk_explode_consume_bits(buf, token_bits);
+            continue;
+        }
+        int token = code->value + (int) ((buf->bit_buffer >> code->bits) & ((1 << code->extra_bits) - 1));
+        pk_explode_consume_bits(buf, token_bits);
+        if (token == PK_EOF) {
+            break;
+        }
+        int length = token - 254;
+        const struct pk_explode_offset_code *offset_code = &buf->offset_codes[buf->bit_buffer & 0xff];
+        int low_bits = length == 2 ? 2 : buf->window_size;
+        if (offset_code->bits + low_bits > buf->bits_in_buffer) {
+            return PK_ERROR_DECODING;
+        }
+        int offset = (offset_code->value << low_bits) |
+            (int) ((buf->bit_buffer >> offset_code->bits) & ((1 << low_bits) - 1));
+        pk_explode_consume_bits(buf, offset_code->bits + low_bits);
+        if (length > out_end - out) {
+            return PK_OUT_OF_SPACE;
+        }
+        pk_explode_copy(output, out, length, offset + 1);
+        out += length;
     }
+    *output_length = (int) (out - output);
     return PK_SUCCESS;
 }
 
@@ -720,8 +865,8 @@ static void zip_output_func(uint8_t *buffer, int length, struct pk_token *token)
     }
 }
 
-int zip_compress(const void *input_buffer, int input_length,
-                 void *output_buffer, int *output_length)
+static int zip_compress_original(const void *input_buffer, int input_length,
+                                 void *output_buffer, int *output_length)
 {
     struct pk_token token;
     struct pk_comp_buffer *buf = (struct pk_comp_buffer *) malloc(sizeof(struct pk_comp_buffer));
@@ -749,28 +894,71 @@ int zip_compress(const void *input_buffer, int input_length,
     return ok;
 }
 
+static int zip_compress_chained(const void *input_buffer, int input_length,
+                                void *output_buffer, int *output_length, zip_compression_level level)
+{
+    struct pk_chain_buffer *buf = (struct pk_chain_buffer *) malloc(sizeof(struct pk_chain_buffer));
+    if (!buf) {
+        return 0;
+    }
+    memset(buf, 0, sizeof(struct pk_chain_buffer));
+    if (level == ZIP_COMPRESSION_MAX) {
+        buf->max_chain_length = PK_CHAIN_DICTIONARY_SIZE;
+        buf->good_length = PK_MAX_COPY_LENGTH;
+    } else if (level == ZIP_COMPRESSION_DEFAULT) {
+        buf->max_chain_length = 64;
+        buf->good_length = 64;
+    } else {
+        buf->max_chain_length = 16;
+        buf->good_length = 32;
+    }
+    buf->output_data = (uint8_t *) output_buffer;
+    buf->output_length = *output_length;
+
+    pk_implode_chained(buf, (const uint8_t *) input_buffer, input_length);
+
+    int ok = 1;
+    if (buf->error) {
+        log_error("COMP Error occurred while compressing.", 0, 0);
+        ok = 0;
+    } else {
+        *output_length = buf->output_ptr;
+    }
+    free(buf);
+    return ok;
+}
+
+int zip_compress(const void *input_buffer, int input_length,
+                 void *output_buffer, int *output_length)
+{
+    return zip_compress_level(input_buffer, input_length, output_buffer, output_length, ZIP_COMPRESSION_DEFAULT);
+}
+
+int zip_compress_level(const void *input_buffer, int input_length,
+                       void *output_buffer, int *output_length, zip_compression_level level)
+{
+    if (level == ZIP_COMPRESSION_ORIGINAL) {
+        return zip_compress_original(input_buffer, input_length, output_buffer, output_length);
+    }
+    return zip_compress_chained(input_buffer, input_length, output_buffer, output_length, level);
+}
+
 int zip_decompress(const void *input_buffer, int input_length,
                    void *output_buffer, int *output_length)
 {
-    struct pk_token token;
     struct pk_decomp_buffer *buf = (struct pk_decomp_buffer *) malloc(sizeof(struct pk_decomp_buffer));
     if (!buf) {
         return 0;
     }
-    memset(buf, 0, sizeof(struct pk_decomp_buffer));
-    memset(&token, 0, sizeof(struct pk_token));
-    token.input_data = (const uint8_t *) input_buffer;
-    token.input_length = input_length;
-    token.output_data = (uint8_t *) output_buffer;
-    token.output_length = *output_length;
-
     int ok = 1;
-    int pk_error = pk_explode(zip_input_func, zip_output_func, buf, &token);
-    if (pk_error || token.stop) {
+    int pk_error = pk_explode(buf, (const uint8_t *) input_buffer, input_length,
+        (uint8_t *) output_buffer, output_length);
+    if (pk_error) {
+        if (pk_error == PK_OUT_OF_SPACE) {
+            log_error("COMP2 Out of buffer space.", 0, 0);
+        }
         log_error("COMP Error uncompressing.", 0, 0);
         ok = 0;
-    } else {
-        *output_length = token.output_ptr;
     }
     free(buf);
     return ok;
@@ -6,6 +6,13 @@
  * Compression functions.
  */
 
+typedef enum {
+    ZIP_COMPRESSION_ORIGINAL, /**< Same output as the original game */
+    ZIP_COMPRESSION_FAST, /**< Short match searches: fastest, slightly larger output */
+    ZIP_COMPRESSION_DEFAULT, /**< Balance between speed and output size, used by zip_compress */
+    ZIP_COMPRESSION_MAX /**< Exhaustive match searches: slow, smallest output */
+} zip_compression_level;
+
 /**
  * Compresses the input buffer.
  * @param input_buffer Input buffer to compress
@@ -16,6 +23,19 @@
  */
 int zip_compress(const void *input_buffer, int input_length, void *output_buffer, int *output_length);
 
+/**
+ * Compresses the input buffer with the given compression level.
+ * All levels can be decompressed by the original game.
+ * @param input_buffer Input buffer to compress
+ * @param input_length Length of input buffer
+ * @param output_buffer Output buffer to write the compressed data to
+ * @param output_length IN: available length of the output buffer, OUT: written bytes
+ * @param level Compression level
+ * @return boolean true on success, false on error
+ */
+int zip_compress_level(const void *input_buffer, int input_length, void *output_buffer, int *output_length,
+    zip_compression_level level);
+
 /**
  * Decompresses the input buffer
  * @param input_buffer Inputbuffer to decompress
@@ -1,5 +1,6 @@
 #include "action.h"
 
+#include "building/house_population.h"
 #include "city/entertainment.h"
 #include "city/figures.h"
 #include "figure/figure.h"
@@ -112,6 +113,7 @@ void figure_action_handle(void)
 {
     city_figures_reset();
     city_entertainment_set_hippodrome_has_race(0);
+    house_population_clear_room_index();
     for (int i = 1; i < MAX_FIGURES; i++) {
         figure *f = figure_get(i);
         if (f->state) {
@@ -72,8 +72,13 @@ void figure_route_add(figure *f)
                 can_travel = map_routing_noncitizen_can_travel_over_land(f->x, f->y,
                     f->destination_x, f->destination_y, f->destination_building_id, 5000);
                 if (!can_travel) {
-                    can_travel = map_routing_noncitizen_can_travel_over_land(f->x, f->y,
-                        f->destination_x, f->destination_y, 0, 25000);
+                    if (f->destination_building_id) {
+                        can_travel = map_routing_noncitizen_can_travel_over_land(f->x, f->y,
+                            f->destination_x, f->destination_y, 0, 25000);
+                    } else {
+                        // same search as above: resume it instead of flooding the map again
+                        can_travel = map_routing_noncitizen_continue_over_land(25000);
+                    }
                     if (!can_travel) {
                         can_travel = map_routing_noncitizen_can_travel_through_everything(
                             f->x, f->y, f->destination_x, f->destination_y);
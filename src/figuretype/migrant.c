@@ -1,10 +1,10 @@
 #include "migrant.h"
 
 #include "building/house.h"
+#include "building/house_population.h"
 #include "building/model.h"
 #include "city/map.h"
 #include "city/population.h"
-#include "core/calc.h"
 #include "core/image.h"
 #include "figure/combat.h"
 #include "figure/image.h"
@@ -58,28 +58,6 @@ static void update_direction_and_image(figure *f)
     }
 }
 
-static int closest_house_with_room(int x, int y)
-{
-    int min_dist = 1000;
-    int min_building_id = 0;
-    int max_id = building_get_highest_id();
-    for (int i = 1; i <= max_id; i++) {
-        building *b = building_get(i);
-        if (b->state == BUILDING_STATE_IN_USE && b->house_size
-            && b->distance_from_entry > 0 && b->house_population_room > 0) {
-            if (!b->immigrant_figure_id) {
-                int dist = calc_maximum_distance(x, y, b->x, b->y);
-                if (dist < min_dist) {
-                    min_dist = dist;
-                    min_building_id = i;
-                }
-            }
-        }
-    }
-    return min_building_id;
-
-}
-
 void figure_immigrant_action(figure *f)
 {
     building *b = building_get(f->immigrant_building_id);
@@ -237,7 +215,7 @@ void figure_homeless_action(figure *f)
             f->image_offset = 0;
             f->wait_ticks++;
             if (f->wait_ticks > 51) {
-                int building_id = closest_house_with_room(f->x, f->y);
+                int building_id = house_population_closest_house_with_room(f->x, f->y);
                 if (building_id) {
                     building *b = building_get(building_id);
                     int x_road, y_road;
@@ -312,7 +290,7 @@ void figure_homeless_action(figure *f)
             f->wait_ticks++;
             if (f->wait_ticks > 30) {
                 f->wait_ticks = 0;
-                int building_id = closest_house_with_room(f->x, f->y);
+                int building_id = house_population_closest_house_with_room(f->x, f->y);
                 if (building_id > 0) {
                     building *b = building_get(building_id);
                     int x_road, y_road;
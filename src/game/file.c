@@ -13,12 +13,17 @@
 #include "city/mission.h"
 #include "city/victory.h"
 #include "city/view.h"
+#include "core/config.h"
+#include "core/dir.h"
 #include "core/encoding.h"
 #include "core/file.h"
 #include "core/image.h"
 #include "core/io.h"
 #include "core/lang.h"
+#include "core/log.h"
 #include "core/string.h"
+#include "core/thread.h"
+#include "core/time.h"
 #include "empire/empire.h"
 #include "empire/trade_prices.h"
 #include "figure/enemy_army.h"
@@ -31,6 +36,7 @@
 #include "game/animation.h"
 #include "game/difficulty.h"
 #include "game/file_io.h"
+#include "game/saved_game_index.h"
 #include "game/settings.h"
 #include "game/state.h"
 #include "game/time.h"
@@ -55,6 +61,7 @@
 #include "map/sprite.h"
 #include "map/terrain.h"
 #include "map/tiles.h"
+#include "platform/file_manager.h"
 #include "scenario/criteria.h"
 #include "scenario/demand_change.h"
 #include "scenario/distant_battle.h"
@@ -71,10 +78,15 @@
 #include "sound/city.h"
 #include "sound/music.h"
 
+#include <stdio.h>
 #include <string.h>
 
 static const char MISSION_PACK_FILE[] = "mission1.pak";
 
+#define MAX_AUTOSAVE_SLOTS 12
+#define MAX_LOAD_STEPS 16
+#define LOAD_SUMMARY_SIZE 400
+
 static const char MISSION_SAVED_GAMES[][32] = {
     "Citizen.sav",
     "Clerk.sav",
@@ -90,6 +102,49 @@ static const char MISSION_SAVED_GAMES[][32] = {
     "Caesar2.sav"
 };
 
+typedef struct {
+    int climate;
+    int enemy;
+    int enemy_loaded;
+} scenario_images;
+
+static struct {
+    const char *names[MAX_LOAD_STEPS];
+    int micros[MAX_LOAD_STEPS];
+    int num_steps;
+    uint64_t start_time;
+    uint64_t step_time;
+} load_timing;
+
+static void load_timing_start(void)
+{
+    load_timing.num_steps = 0;
+    load_timing.start_time = load_timing.step_time = time_get_micros();
+}
+
+static void load_timing_step(const char *name)
+{
+    uint64_t now = time_get_micros();
+    if (load_timing.num_steps < MAX_LOAD_STEPS) {
+        load_timing.names[load_timing.num_steps] = name;
+        load_timing.micros[load_timing.num_steps] = (int) (now - load_timing.step_time);
+        load_timing.num_steps++;
+    }
+    load_timing.step_time = now;
+}
+
+static void load_timing_log(void)
+{
+    char summary[LOAD_SUMMARY_SIZE];
+    int index = 0;
+    summary[0] = 0;
+    for (int i = 0; i < load_timing.num_steps && index < LOAD_SUMMARY_SIZE; i++) {
+        index += snprintf(&summary[index], LOAD_SUMMARY_SIZE - index, "%s%s %.1f", i ? ", " : "",
+            load_timing.names[i], load_timing.micros[i] / 1000.0);
+    }
+    log_info("Load time in ms:", summary, (int) ((load_timing.step_time - load_timing.start_time) / 1000));
+}
+
 static void clear_scenario_data(void)
 {
     // clear data
@@ -207,23 +262,35 @@ static void load_empire_data(int is_custom_scenario, int empire_id)
     scenario_distant_battle_set_enemy_travel_months();
 }
 
-static void initialize_saved_game(void)
+static int load_scenario_images(void *data)
+{
+    scenario_images *images = data;
+    image_load_climate(images->climate, 0, 0);
+    images->enemy_loaded = image_load_enemy(images->enemy);
+    return 0;
+}
+
+static void initialize_saved_game(const scenario_images *preloaded)
 {
     load_empire_data(scenario_is_custom(), scenario_empire_id());
 
     scenario_map_init();
 
     city_view_init();
+    load_timing_step("empire");
 
     map_routing_update_all();
+    load_timing_step("routing");
 
     map_orientation_update_buildings();
     figure_route_clean();
     map_road_network_update();
+    load_timing_step("roads");
     building_maintenance_check_rome_access();
     building_granaries_calculate_stocks();
     building_menu_update();
     city_message_init_problem_areas();
+    load_timing_step("buildings");
 
     sound_city_init();
 
@@ -234,14 +301,19 @@ static void initialize_saved_game(void)
     city_mission_tutorial_set_fire_message_shown(1);
     city_mission_tutorial_set_disease_message_shown(1);
 
+    // Images may already have been loaded while the saved game was decoded
     image_load_climate(scenario_property_climate(), 0, 0);
-    image_load_enemy(scenario_property_enemy());
+    if (!preloaded || !preloaded->enemy_loaded || preloaded->enemy != scenario_property_enemy()) {
+        image_load_enemy(scenario_property_enemy());
+    }
+    load_timing_step("images");
     city_military_determine_distant_battle_city();
     map_tiles_determine_gardens();
 
     city_message_clear_scroll();
 
     game_state_unpause();
+    load_timing_step("other");
 }
 
 static int get_campaign_mission_offset(int mission_id)
@@ -261,17 +333,20 @@ static int load_campaign_mission(int mission_id)
     if (offset <= 0) {
         return 0;
     }
+    load_timing_start();
     if (!game_file_io_read_saved_game(MISSION_PACK_FILE, offset)) {
         return 0;
     }
+    load_timing_step("decode");
 
     if (mission_id == 0) {
         scenario_set_player_name(setting_player_name());
     } else {
         scenario_restore_campaign_player_name();
     }
-    initialize_saved_game();
+    initialize_saved_game(0);
     city_data_init_campaign_mission();
+    load_timing_log();
     return 1;
 }
 
@@ -349,11 +424,34 @@ int game_file_load_scenario_data(const char *scenario_file)
 
 int game_file_load_saved_game(const char *filename)
 {
-    if (!game_file_io_read_saved_game(filename, 0)) {
+    load_timing_start();
+    // Start loading the images for the city while the saved game is decoded
+    thread *image_loader = 0;
+    saved_game_info info;
+    scenario_images images = {0};
+    const char *path = dir_get_file(filename, NOT_LOCALIZED);
+    if (path && game_file_io_read_saved_game_info(path, &info)) {
+        images.climate = info.climate;
+        images.enemy = info.enemy;
+        image_loader = thread_create(load_scenario_images, "image loader", &images);
+    }
+    int result = game_file_io_read_saved_game(filename, 0);
+    load_timing_step("decode");
+    if (image_loader) {
+        thread_wait(image_loader);
+        load_timing_step("wait for images");
+    }
+    if (!result) {
+        if (image_loader) {
+            // the running city is kept: put its images back
+            image_load_climate(scenario_property_climate(), 0, 0);
+            image_load_enemy(scenario_property_enemy());
+        }
         return 0;
     }
-    initialize_saved_game();
+    initialize_saved_game(image_loader ? &images : 0);
     building_storage_reset_building_ids();
+    load_timing_log();
 
     sound_music_update(1);
     return 1;
@@ -361,12 +459,53 @@ int game_file_load_saved_game(const char *filename)
 
 int game_file_write_saved_game(const char *filename)
 {
-    return game_file_io_write_saved_game(filename);
+    int result = game_file_io_write_saved_game(filename);
+    saved_game_index_invalidate(filename);
+    return result;
+}
+
+int game_file_write_native_saved_game(const char *filename)
+{
+    int result = game_file_io_write_saved_game_format(filename, SAVEGAME_FORMAT_NATIVE);
+    saved_game_index_invalidate(filename);
+    return result;
+}
+
+int game_file_write_autosave(void)
+{
+    int slots = config_get(CONFIG_GP_AUTOSAVE_SLOTS);
+    if (slots <= 1) {
+        return game_file_write_native_saved_game("autosave." NATIVE_SAVED_GAME_EXTENSION);
+    }
+    if (slots > MAX_AUTOSAVE_SLOTS) {
+        slots = MAX_AUTOSAVE_SLOTS;
+    }
+    // Write to the first missing slot, or else to the least recently written one
+    char filename[FILE_NAME_MAX];
+    int oldest_slot = 0;
+    long long oldest_modified = 0;
+    for (int slot = 0; slot < slots; slot++) {
+        snprintf(filename, FILE_NAME_MAX, "autosave-%d." NATIVE_SAVED_GAME_EXTENSION, slot + 1);
+        int size;
+        long long modified;
+        if (!platform_file_manager_get_file_stats(filename, &size, &modified)) {
+            oldest_slot = slot;
+            break;
+        }
+        if (slot == 0 || modified < oldest_modified) {
+            oldest_slot = slot;
+            oldest_modified = modified;
+        }
+    }
+    snprintf(filename, FILE_NAME_MAX, "autosave-%d." NATIVE_SAVED_GAME_EXTENSION, oldest_slot + 1);
+    return game_file_write_native_saved_game(filename);
 }
 
 int game_file_delete_saved_game(const char *filename)
 {
-    return game_file_io_delete_saved_game(filename);
+    int result = game_file_io_delete_saved_game(filename);
+    saved_game_index_invalidate(filename);
+    return result;
 }
 
 void game_file_write_mission_saved_game(void)
@@ -387,5 +526,6 @@ void game_file_write_mission_saved_game(void)
     }
     if (city_mission_should_save_start() && !file_exists(filename, NOT_LOCALIZED)) {
         game_file_io_write_saved_game(filename);
+        saved_game_index_invalidate(filename);
     }
 }
@@ -3,6 +3,12 @@
 
 #include <stdint.h>
 
+/**
+ * Extension of saved games in the native format, which the original game cannot read.
+ * Classic saved games keep the "sav" extension.
+ */
+#define NATIVE_SAVED_GAME_EXTENSION "jsav"
+
 /**
  * Start scenario by name
  * @param scenario_name Name of the scenario without extension
@@ -38,6 +44,24 @@ int game_file_load_saved_game(const char *filename);
  */
 int game_file_write_saved_game(const char *filename);
 
+/**
+ * Write saved game to disk in Julius' native format, which is faster to write and load.
+ * The original game cannot read these files.
+ * @param filename File to save to
+ * @return Boolean true on success, false on failure
+ */
+int game_file_write_native_saved_game(const char *filename);
+
+/**
+ * Write the monthly autosave in the native format.
+ * Pieces that did not change since the previous native save are not compressed again.
+ * When more than one autosave slot is configured, the autosaves rotate through
+ * autosave-1.jsav to autosave-N.jsav: a missing slot is filled first, otherwise the
+ * least recently written file is replaced. Each file is a complete saved game.
+ * @return Boolean true on success, false on failure
+ */
+int game_file_write_autosave(void);
+
 /**
  * Delete saved game
  * @param filename File to delete
@@ -7,11 +7,13 @@
 #include "city/culture.h"
 #include "city/data.h"
 #include "core/file.h"
+#include "core/hash.h"
 #include "core/log.h"
 #include "city/message.h"
 #include "city/view.h"
 #include "core/dir.h"
 #include "core/random.h"
+#include "core/thread_pool.h"
 #include "core/zip.h"
 #include "empire/city.h"
 #include "empire/empire.h"
@@ -48,12 +50,16 @@
 #include <stdlib.h>
 #include <string.h>
 
-#define COMPRESS_BUFFER_SIZE 600000
 #define UNCOMPRESSED 0x80000000
+#define MAX_SAVEGAME_PIECES 100
 
-static const int SAVE_GAME_VERSION = 0x66;
+// Julius' native format: a header, a directory with one entry per piece, then the piece data
+#define NATIVE_MAGIC "JSAV"
+#define NATIVE_FORMAT_VERSION 1
+#define NATIVE_HEADER_SIZE 12
+#define NATIVE_DIRECTORY_ENTRY_SIZE 28
 
-static char compress_buffer[COMPRESS_BUFFER_SIZE];
+static const int SAVE_GAME_VERSION = 0x66;
 
 static int savegame_version;
 
@@ -62,6 +68,32 @@ typedef struct {
     int compressed;
 } file_piece;
 
+enum {
+    CHUNK_CODEC_NONE = 0,
+    CHUNK_CODEC_IMPLODE = 1
+};
+
+typedef struct {
+    uint64_t checksum;
+    uint8_t *data;
+    int size;
+} previous_chunk;
+
+typedef struct {
+    file_piece *piece;
+    uint8_t *data;
+    int size;
+    int codec;
+    zip_compression_level level;
+    const previous_chunk *previous;
+    uint64_t checksum;
+    int has_checksum;
+    int ok;
+} file_chunk;
+
+// Compressed chunks of the previous native save, to reuse for pieces that did not change
+static previous_chunk previous_chunks[MAX_SAVEGAME_PIECES];
+
 typedef struct {
     buffer *graphic_ids;
     buffer *edge;
@@ -169,10 +201,30 @@ typedef struct {
 
 static struct {
     int num_pieces;
-    file_piece pieces[100];
+    file_piece pieces[MAX_SAVEGAME_PIECES];
     savegame_state state;
 } savegame_data = {0};
 
+typedef struct {
+    int size;
+    int compressed;
+} piece_layout;
+
+// Layout of the saved game pieces, which never changes once the pieces are created.
+// The pieces themselves are reset on every load and save, so the summary reader only uses this.
+static struct {
+    int num_pieces;
+    piece_layout pieces[MAX_SAVEGAME_PIECES];
+    struct {
+        int mission;
+        int player_name;
+        int scenario_name;
+        int game_time;
+        int scenario;
+        int city_data;
+    } summary;
+} savegame_layout;
+
 static void init_file_piece(file_piece *piece, int size, int compressed)
 {
     piece->compressed = compressed;
@@ -216,6 +268,32 @@ static void init_scenario_data(void)
     state->end_marker = create_scenario_piece(4);
 }
 
+static int savegame_piece_index(const buffer *buf)
+{
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        if (&savegame_data.pieces[i].buf == buf) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+static void init_savegame_layout(void)
+{
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        savegame_layout.pieces[i].size = savegame_data.pieces[i].buf.size;
+        savegame_layout.pieces[i].compressed = savegame_data.pieces[i].compressed;
+    }
+    const savegame_state *state = &savegame_data.state;
+    savegame_layout.summary.mission = savegame_piece_index(state->scenario_campaign_mission);
+    savegame_layout.summary.player_name = savegame_piece_index(state->player_name);
+    savegame_layout.summary.scenario_name = savegame_piece_index(state->scenario_name);
+    savegame_layout.summary.game_time = savegame_piece_index(state->game_time);
+    savegame_layout.summary.scenario = savegame_piece_index(state->scenario);
+    savegame_layout.summary.city_data = savegame_piece_index(state->city_data);
+    savegame_layout.num_pieces = savegame_data.num_pieces;
+}
+
 static void init_savegame_data(void)
 {
     if (savegame_data.num_pieces > 0) {
@@ -308,6 +386,7 @@ static void init_savegame_data(void)
     state->tutorial_part3 = create_savegame_piece(4, 0);
     state->city_entry_exit_grid_offset = create_savegame_piece(8, 0);
     state->end_marker = create_savegame_piece(284, 0); // 71x 4-bytes emptiness
+    init_savegame_layout();
 }
 
 static void scenario_load_from_state(scenario_state *file)
@@ -544,92 +623,385 @@ int game_file_io_write_scenario(const char *filename)
     return 1;
 }
 
-static int read_int32(FILE *fp)
+static void write_int32(FILE *fp, int value)
 {
     uint8_t data[4];
-    if (fread(&data, 1, 4, fp) != 4) {
-        return 0;
-    }
     buffer buf;
     buffer_init(&buf, data, 4);
-    return buffer_read_i32(&buf);
+    buffer_write_i32(&buf, value);
+    fwrite(&data, 1, 4, fp);
 }
 
-static void write_int32(FILE *fp, int value)
+static void decode_chunk(int index, void *data)
+{
+    file_chunk *chunk = &((file_chunk *) data)[index];
+    buffer *buf = &chunk->piece->buf;
+    if (chunk->codec == CHUNK_CODEC_IMPLODE) {
+        int output_size = buf->size;
+        chunk->ok = zip_decompress(chunk->data, chunk->size, buf->data, &output_size);
+    } else {
+        memcpy(buf->data, chunk->data, chunk->size < buf->size ? chunk->size : buf->size);
+        chunk->ok = chunk->size == buf->size;
+    }
+    if (chunk->ok && chunk->has_checksum) {
+        chunk->ok = hash_data(buf->data, buf->size) == chunk->checksum;
+    }
+}
+
+static void encode_chunk(int index, void *data)
+{
+    file_chunk *chunk = &((file_chunk *) data)[index];
+    buffer *buf = &chunk->piece->buf;
+    chunk->checksum = hash_data(buf->data, buf->size);
+    if (chunk->codec == CHUNK_CODEC_IMPLODE && chunk->previous &&
+        chunk->previous->data && chunk->previous->checksum == chunk->checksum) {
+        chunk->data = chunk->previous->data;
+        chunk->size = chunk->previous->size;
+        return;
+    }
+    // store the piece as-is when it does not compress to something smaller
+    if (chunk->codec == CHUNK_CODEC_IMPLODE &&
+        (!chunk->data || !zip_compress_level(buf->data, buf->size, chunk->data, &chunk->size, chunk->level) ||
+        chunk->size >= buf->size)) {
+        chunk->codec = CHUNK_CODEC_NONE;
+    }
+    if (chunk->codec == CHUNK_CODEC_NONE) {
+        chunk->data = buf->data;
+        chunk->size = buf->size;
+    }
+}
+
+static uint8_t *read_remaining_file(FILE *fp, int *size)
+{
+    long start = ftell(fp);
+    if (start < 0 || fseek(fp, 0, SEEK_END) != 0) {
+        return 0;
+    }
+    long end = ftell(fp);
+    if (end < start || fseek(fp, start, SEEK_SET) != 0) {
+        return 0;
+    }
+    *size = (int) (end - start);
+    uint8_t *data = (uint8_t *) malloc(*size > 0 ? *size : 1);
+    if (data && fread(data, 1, *size, fp) != *size) {
+        free(data);
+        return 0;
+    }
+    return data;
+}
+
+static int is_native_savegame(const uint8_t *file_data, int file_size)
+{
+    return file_size >= NATIVE_HEADER_SIZE && memcmp(file_data, NATIVE_MAGIC, 4) == 0;
+}
+
+static int read_classic_chunks(uint8_t *file_data, int file_size, file_chunk *chunks, int *num_chunks)
 {
-    uint8_t data[4];
     buffer buf;
-    buffer_init(&buf, data, 4);
-    buffer_write_i32(&buf, value);
-    fwrite(&data, 1, 4, fp);
+    buffer_init(&buf, file_data, file_size);
+    int last_piece = savegame_layout.num_pieces - 1;
+    for (int i = 0; i < savegame_layout.num_pieces; i++) {
+        const piece_layout *piece = &savegame_layout.pieces[i];
+        file_chunk *chunk = &chunks[i];
+        chunk->piece = 0;
+        chunk->codec = CHUNK_CODEC_NONE;
+        chunk->size = piece->size;
+        chunk->has_checksum = 0;
+        if (piece->compressed) {
+            int input_size = buffer_read_i32(&buf);
+            if ((unsigned int) input_size != UNCOMPRESSED) {
+                chunk->codec = CHUNK_CODEC_IMPLODE;
+                chunk->size = input_size;
+            }
+        }
+        int available = file_size - buf.index;
+        if (chunk->size < 0 || chunk->size > available) {
+            // The last piece may be smaller than buf.size
+            if (i != last_piece) {
+                return 0;
+            }
+            if (chunk->codec == CHUNK_CODEC_IMPLODE || available < 0) {
+                chunk->codec = CHUNK_CODEC_NONE;
+                available = 0;
+            }
+            chunk->size = available;
+        }
+        chunk->data = &file_data[buf.index];
+        buffer_skip(&buf, chunk->size);
+    }
+    *num_chunks = savegame_layout.num_pieces;
+    return 1;
 }
 
-static int read_compressed_chunk(FILE *fp, void *buffer, int bytes_to_read)
+static int read_native_chunks(uint8_t *file_data, int file_size, file_chunk *chunks, int *num_chunks)
 {
-    if (bytes_to_read > COMPRESS_BUFFER_SIZE) {
+    buffer buf;
+    buffer_init(&buf, file_data, file_size);
+    buffer_skip(&buf, 4);
+    int version = buffer_read_i32(&buf);
+    int num_entries = buffer_read_i32(&buf);
+    if (version != NATIVE_FORMAT_VERSION || num_entries != savegame_layout.num_pieces ||
+        file_size < NATIVE_HEADER_SIZE + num_entries * NATIVE_DIRECTORY_ENTRY_SIZE) {
         return 0;
     }
-    int input_size = read_int32(fp);
-    if ((unsigned int) input_size == UNCOMPRESSED) {
-        if (fread(buffer, 1, bytes_to_read, fp) != bytes_to_read) {
+    memset(chunks, 0, num_entries * sizeof(file_chunk));
+    for (int i = 0; i < num_entries; i++) {
+        int id = buffer_read_i32(&buf);
+        int offset = buffer_read_i32(&buf);
+        int stored_size = buffer_read_i32(&buf);
+        int size = buffer_read_i32(&buf);
+        int codec = buffer_read_i32(&buf);
+        uint64_t checksum = buffer_read_u32(&buf);
+        checksum |= (uint64_t) buffer_read_u32(&buf) << 32;
+        if (id < 0 || id >= num_entries || chunks[id].data ||
+            offset < 0 || stored_size < 0 || offset > file_size - stored_size ||
+            size != savegame_layout.pieces[id].size ||
+            (codec != CHUNK_CODEC_NONE && codec != CHUNK_CODEC_IMPLODE)) {
             return 0;
         }
+        file_chunk *chunk = &chunks[id];
+        chunk->data = &file_data[offset];
+        chunk->size = stored_size;
+        chunk->codec = codec;
+        chunk->checksum = checksum;
+        chunk->has_checksum = 1;
+    }
+    *num_chunks = num_entries;
+    return 1;
+}
+
+static int locate_chunks(uint8_t *file_data, int file_size, file_chunk *chunks, int *num_chunks, int *is_native)
+{
+    *is_native = is_native_savegame(file_data, file_size);
+    if (*is_native) {
+        return read_native_chunks(file_data, file_size, chunks, num_chunks);
     } else {
-        if (fread(compress_buffer, 1, input_size, fp) != input_size
-            || !zip_decompress(compress_buffer, input_size, buffer, &bytes_to_read)) {
-            return 0;
+        return read_classic_chunks(file_data, file_size, chunks, num_chunks);
+    }
+}
+
+static int savegame_read_from_file(FILE *fp)
+{
+    int file_size;
+    uint8_t *file_data = read_remaining_file(fp, &file_size);
+    if (!file_data) {
+        return 0;
+    }
+    // Locate the chunks first, so they can be decoded in parallel
+    file_chunk chunks[MAX_SAVEGAME_PIECES];
+    int num_chunks = 0;
+    int is_native;
+    int result = locate_chunks(file_data, file_size, chunks, &num_chunks, &is_native);
+    if (result) {
+        // Chunks are located by piece index: point them to the pieces to decode into
+        for (int i = 0; i < num_chunks; i++) {
+            chunks[i].piece = &savegame_data.pieces[i];
+        }
+        thread_pool_run(decode_chunk, num_chunks, chunks);
+        for (int i = 0; i < num_chunks; i++) {
+            if (!chunks[i].ok && (is_native || i != num_chunks - 1)) {
+                result = 0;
+            }
         }
     }
-    return 1;
+    free(file_data);
+    return result;
+}
+
+// Decodes the chunk of a single piece into the given memory, leaving the piece itself untouched
+static int decode_chunk_copy(const file_chunk *chunks, int index, uint8_t *data)
+{
+    file_piece piece;
+    piece.compressed = savegame_layout.pieces[index].compressed;
+    buffer_init(&piece.buf, data, savegame_layout.pieces[index].size);
+    file_chunk chunk = chunks[index];
+    chunk.piece = &piece;
+    decode_chunk(0, &chunk);
+    return chunk.ok;
 }
 
-static int write_compressed_chunk(FILE *fp, const void *buffer, int bytes_to_write)
+static int read_saved_game_info(uint8_t *file_data, int file_size, saved_game_info *info)
 {
-    if (bytes_to_write > COMPRESS_BUFFER_SIZE) {
+    file_chunk chunks[MAX_SAVEGAME_PIECES];
+    int num_chunks = 0;
+    int is_native;
+    if (!savegame_layout.num_pieces || !locate_chunks(file_data, file_size, chunks, &num_chunks, &is_native)) {
         return 0;
     }
-    int output_size = COMPRESS_BUFFER_SIZE;
-    if (zip_compress(buffer, bytes_to_write, compress_buffer, &output_size)) {
-        write_int32(fp, output_size);
-        fwrite(compress_buffer, 1, output_size, fp);
-    } else {
-        // unable to compress: write uncompressed
-        write_int32(fp, UNCOMPRESSED);
-        fwrite(buffer, 1, bytes_to_write, fp);
+    uint8_t mission[4];
+    uint8_t player_name[2 * MAX_PLAYER_NAME];
+    uint8_t time[20];
+    uint8_t scenario[1720];
+    int city_size = savegame_layout.pieces[savegame_layout.summary.city_data].size;
+    uint8_t *city = (uint8_t *) malloc(city_size);
+    if (!city ||
+        !decode_chunk_copy(chunks, savegame_layout.summary.scenario, scenario) ||
+        !decode_chunk_copy(chunks, savegame_layout.summary.mission, mission) ||
+        !decode_chunk_copy(chunks, savegame_layout.summary.player_name, player_name) ||
+        !decode_chunk_copy(chunks, savegame_layout.summary.scenario_name, info->scenario_name) ||
+        !decode_chunk_copy(chunks, savegame_layout.summary.game_time, time) ||
+        !decode_chunk_copy(chunks, savegame_layout.summary.city_data, city)) {
+        free(city);
+        return 0;
     }
+    buffer buf;
+    buffer_init(&buf, mission, 4);
+    info->mission = buffer_read_i32(&buf);
+
+    buffer_init(&buf, player_name, 2 * MAX_PLAYER_NAME);
+    buffer_skip(&buf, MAX_PLAYER_NAME);
+    buffer_read_raw(&buf, info->player_name, MAX_PLAYER_NAME);
+    info->player_name[MAX_PLAYER_NAME - 1] = 0;
+    info->scenario_name[MAX_SCENARIO_NAME - 1] = 0;
+
+    // tick, day, month, year
+    buffer_init(&buf, time, 20);
+    buffer_skip(&buf, 8);
+    info->month = buffer_read_i32(&buf);
+    info->year = buffer_read_i32(&buf);
+
+    buffer_init(&buf, scenario, sizeof(scenario));
+    scenario_read_climate_and_enemy(&buf, &info->climate, &info->enemy);
+
+    buffer_init(&buf, city, city_size);
+    city_data_read_summary(&buf, &info->treasury, &info->population);
+    free(city);
     return 1;
 }
 
-static int savegame_read_from_file(FILE *fp)
+static uint8_t *encode_chunks(file_chunk *chunks, savegame_format format)
 {
+    int total_size = 0;
     for (int i = 0; i < savegame_data.num_pieces; i++) {
         file_piece *piece = &savegame_data.pieces[i];
-        int result = 0;
-        if (piece->compressed) {
-            result = read_compressed_chunk(fp, piece->buf.data, piece->buf.size);
-        } else {
-            result = fread(piece->buf.data, 1, piece->buf.size, fp) == piece->buf.size;
+        file_chunk *chunk = &chunks[i];
+        chunk->piece = piece;
+        chunk->data = 0;
+        chunk->size = 0;
+        chunk->codec = CHUNK_CODEC_NONE;
+        chunk->level = format == SAVEGAME_FORMAT_CLASSIC ? ZIP_COMPRESSION_DEFAULT : ZIP_COMPRESSION_FAST;
+        chunk->previous = format == SAVEGAME_FORMAT_NATIVE ? &previous_chunks[i] : 0;
+        if (piece->compressed && format != SAVEGAME_FORMAT_NATIVE_UNCOMPRESSED) {
+            chunk->codec = CHUNK_CODEC_IMPLODE;
+            // implode needs at most 9 bits per byte, plus header and end marker
+            chunk->size = piece->buf.size + piece->buf.size / 8 + 16;
+            total_size += chunk->size;
         }
-        // The last piece may be smaller than buf.size
-        if (!result && i != (savegame_data.num_pieces - 1)) {
-            return 0;
+    }
+    uint8_t *output = total_size ? (uint8_t *) malloc(total_size) : 0;
+    int output_offset = 0;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        if (output && chunks[i].codec == CHUNK_CODEC_IMPLODE) {
+            chunks[i].data = &output[output_offset];
+            output_offset += chunks[i].size;
         }
     }
-    return 1;
+    thread_pool_run(encode_chunk, savegame_data.num_pieces, chunks);
+    return output;
 }
 
-static void savegame_write_to_file(FILE *fp)
+static void write_classic_chunks(FILE *fp, const file_chunk *chunks)
 {
     for (int i = 0; i < savegame_data.num_pieces; i++) {
-        file_piece *piece = &savegame_data.pieces[i];
-        if (piece->compressed) {
-            write_compressed_chunk(fp, piece->buf.data, piece->buf.size);
+        const file_chunk *chunk = &chunks[i];
+        if (!chunk->piece->compressed) {
+            fwrite(chunk->data, 1, chunk->size, fp);
+        } else if (chunk->codec == CHUNK_CODEC_IMPLODE) {
+            write_int32(fp, chunk->size);
+            fwrite(chunk->data, 1, chunk->size, fp);
         } else {
-            fwrite(piece->buf.data, 1, piece->buf.size, fp);
+            // unable to compress: write uncompressed
+            write_int32(fp, UNCOMPRESSED);
+            fwrite(chunk->data, 1, chunk->size, fp);
         }
     }
 }
 
+static void write_native_chunks(FILE *fp, const file_chunk *chunks)
+{
+    uint8_t header[NATIVE_HEADER_SIZE + MAX_SAVEGAME_PIECES * NATIVE_DIRECTORY_ENTRY_SIZE];
+    buffer buf;
+    buffer_init(&buf, header, sizeof(header));
+    buffer_write_raw(&buf, NATIVE_MAGIC, 4);
+    buffer_write_i32(&buf, NATIVE_FORMAT_VERSION);
+    buffer_write_i32(&buf, savegame_data.num_pieces);
+    int offset = NATIVE_HEADER_SIZE + savegame_data.num_pieces * NATIVE_DIRECTORY_ENTRY_SIZE;
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const file_chunk *chunk = &chunks[i];
+        buffer_write_i32(&buf, i);
+        buffer_write_i32(&buf, offset);
+        buffer_write_i32(&buf, chunk->size);
+        buffer_write_i32(&buf, chunk->piece->buf.size);
+        buffer_write_i32(&buf, chunk->codec);
+        buffer_write_u32(&buf, (uint32_t) chunk->checksum);
+        buffer_write_u32(&buf, (uint32_t) (chunk->checksum >> 32));
+        offset += chunk->size;
+    }
+    fwrite(header, 1, buf.index, fp);
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        fwrite(chunks[i].data, 1, chunks[i].size, fp);
+    }
+}
+
+static void update_previous_chunks(const file_chunk *chunks)
+{
+    for (int i = 0; i < savegame_data.num_pieces; i++) {
+        const file_chunk *chunk = &chunks[i];
+        previous_chunk *previous = &previous_chunks[i];
+        if (chunk->data == previous->data) {
+            continue;
+        }
+        free(previous->data);
+        previous->data = 0;
+        if (chunk->codec == CHUNK_CODEC_IMPLODE) {
+            previous->data = (uint8_t *) malloc(chunk->size);
+            if (previous->data) {
+                memcpy(previous->data, chunk->data, chunk->size);
+                previous->size = chunk->size;
+                previous->checksum = chunk->checksum;
+            }
+        }
+    }
+}
+
+static void savegame_write_to_file(FILE *fp, savegame_format format)
+{
+    file_chunk chunks[MAX_SAVEGAME_PIECES];
+    uint8_t *output = encode_chunks(chunks, format);
+    if (format == SAVEGAME_FORMAT_CLASSIC) {
+        write_classic_chunks(fp, chunks);
+    } else {
+        write_native_chunks(fp, chunks);
+    }
+    if (format == SAVEGAME_FORMAT_NATIVE) {
+        update_previous_chunks(chunks);
+    }
+    free(output);
+}
+
+void game_file_io_init(void)
+{
+    init_savegame_data();
+}
+
+int game_file_io_read_saved_game_info(const char *filename, saved_game_info *info)
+{
+    FILE *fp = file_open(filename, "rb");
+    if (!fp) {
+        return 0;
+    }
+    int file_size;
+    uint8_t *file_data = read_remaining_file(fp, &file_size);
+    file_close(fp);
+    if (!file_data) {
+        return 0;
+    }
+    info->file_size = file_size;
+    int result = read_saved_game_info(file_data, file_size, info);
+    free(file_data);
+    return result;
+}
+
 int game_file_io_read_saved_game(const char *filename, int offset)
 {
     init_savegame_data();
@@ -654,6 +1026,11 @@ int game_file_io_read_saved_game(const char *filename, int offset)
 }
 
 int game_file_io_write_saved_game(const char *filename)
+{
+    return game_file_io_write_saved_game_format(filename, SAVEGAME_FORMAT_CLASSIC);
+}
+
+int game_file_io_write_saved_game_format(const char *filename, savegame_format format)
 {
     init_savegame_data();
 
@@ -666,7 +1043,7 @@ int game_file_io_write_saved_game(const char *filename)
         log_error("Unable to save game", 0, 0);
         return 0;
     }
-    savegame_write_to_file(fp);
+    savegame_write_to_file(fp, format);
     file_close(fp);
     return 1;
 }
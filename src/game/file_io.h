@@ -1,14 +1,50 @@
 #ifndef GAME_FILE_IO_H
 #define GAME_FILE_IO_H
 
+#include "scenario/data.h"
+
+#include <stdint.h>
+
+typedef enum {
+    SAVEGAME_FORMAT_CLASSIC, /**< Same layout as the original game */
+    SAVEGAME_FORMAT_NATIVE, /**< Julius-only layout with a chunk directory and fast compression */
+    SAVEGAME_FORMAT_NATIVE_UNCOMPRESSED /**< Julius-only layout without compression */
+} savegame_format;
+
+typedef struct {
+    int file_size;
+    int mission;
+    int month;
+    int year;
+    int population;
+    int treasury;
+    int climate;
+    int enemy;
+    uint8_t player_name[MAX_PLAYER_NAME];
+    uint8_t scenario_name[MAX_SCENARIO_NAME];
+} saved_game_info;
+
+void game_file_io_init(void);
+
 int game_file_io_read_scenario(const char *filename);
 
 int game_file_io_write_scenario(const char *filename);
 
 int game_file_io_read_saved_game(const char *filename, int offset);
 
+/**
+ * Reads the summary of a saved game without loading it. Only the pieces needed for the summary are decoded
+ * and no game state is changed, so this can run on any thread once game_file_io_init() has been called.
+ * @param filename Exact name of the file, as found in the directory listing
+ * @param info Summary to fill in
+ * @return Boolean true on success, false on failure
+ */
+int game_file_io_read_saved_game_info(const char *filename, saved_game_info *info);
+
 int game_file_io_write_saved_game(const char *filename);
 
+int game_file_io_write_saved_game_format(const char *filename, savegame_format format);
+
 int game_file_io_delete_saved_game(const char *filename);
 
 #endif // GAME_FILE_IO_H
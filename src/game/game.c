@@ -3,22 +3,28 @@
 #include "building/model.h"
 #include "city/view.h"
 #include "core/config.h"
+#include "core/dir.h"
+#include "core/file.h"
 #include "core/hotkey_config.h"
 #include "core/image.h"
 #include "core/lang.h"
 #include "core/locale.h"
 #include "core/log.h"
 #include "core/random.h"
+#include "core/thread_pool.h"
 #include "editor/editor.h"
 #include "figure/type.h"
 #include "game/animation.h"
 #include "game/file.h"
 #include "game/file_editor.h"
+#include "game/file_io.h"
+#include "game/saved_game_index.h"
 #include "game/settings.h"
 #include "game/speed.h"
 #include "game/state.h"
 #include "game/tick.h"
 #include "graphics/font.h"
+#include "graphics/screenshot.h"
 #include "graphics/video.h"
 #include "graphics/window.h"
 #include "scenario/property.h"
@@ -30,6 +36,8 @@
 #include "window/logo.h"
 #include "window/main_menu.h"
 
+#include <string.h>
+
 static void errlog(const char *msg)
 {
     log_error(msg, 0, 0);
@@ -104,6 +112,8 @@ int game_init(void)
     }
 
     sound_system_init();
+    thread_pool_init(0);
+    game_file_io_init();
     game_state_init();
     window_logo_show(missing_fonts ? MESSAGE_MISSING_FONTS : (is_unpatched() ? MESSAGE_MISSING_PATCH : MESSAGE_NONE));
 
@@ -185,10 +195,33 @@ void game_draw(void)
     sound_city_play();
 }
 
+int game_export_city_images(void)
+{
+    const char *extensions[] = {"sav", NATIVE_SAVED_GAME_EXTENSION};
+    const dir_listing *saves = dir_find_files_with_extensions(extensions, 2);
+    int exported = 0;
+    for (int i = 0; i < saves->num_files; i++) {
+        char image_filename[FILE_NAME_MAX];
+        strncpy(image_filename, saves->files[i], FILE_NAME_MAX - 1);
+        image_filename[FILE_NAME_MAX - 1] = 0;
+        file_change_extension(image_filename, "png");
+        if (game_file_load_saved_game(saves->files[i]) &&
+            graphics_save_full_city_screenshot(image_filename)) {
+            exported++;
+        } else {
+            log_error("Unable to export city image for", saves->files[i], 0);
+        }
+    }
+    log_info("Exported city images:", 0, exported);
+    return exported == saves->num_files;
+}
+
 void game_exit(void)
 {
     video_shutdown();
     settings_save();
     config_save();
     sound_system_shutdown();
+    saved_game_index_shutdown();
+    thread_pool_shutdown();
 }
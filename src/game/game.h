@@ -15,6 +15,13 @@ void game_draw(void);
 
 void game_exit_editor(void);
 
+/**
+ * Loads each saved game in the data directory and writes an image of the
+ * whole city next to it, with the same name and a png extension
+ * @return 1 if all images were written, 0 otherwise
+ */
+int game_export_city_images(void);
+
 void game_exit(void);
 
 #endif // GAME_GAME_H
@@ -0,0 +1,251 @@
+#include "saved_game_index.h"
+
+#include "core/file.h"
+#include "core/thread.h"
+#include "platform/file_manager.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+    ENTRY_NEEDS_READ = 0,
+    ENTRY_NEEDS_CHECK = 1,
+    ENTRY_IN_PROGRESS = 2,
+    ENTRY_READY = 3,
+    ENTRY_FAILED = 4
+};
+
+typedef struct {
+    char filename[FILE_NAME_MAX];
+    int state;
+    int has_info;
+    long long modified;
+    saved_game_info info;
+} index_entry;
+
+static struct {
+    index_entry *entries;
+    int num_entries;
+    thread *worker;
+    thread_mutex *mutex;
+    thread_condition *work_available;
+    int quit;
+    int started;
+} data;
+
+static void lock(void)
+{
+    if (data.worker) {
+        thread_mutex_lock(data.mutex);
+    }
+}
+
+static void unlock(void)
+{
+    if (data.worker) {
+        thread_mutex_unlock(data.mutex);
+    }
+}
+
+static index_entry *find_entry(const char *filename)
+{
+    int left = 0;
+    int right = data.num_entries - 1;
+    while (left <= right) {
+        int middle = (left + right) / 2;
+        int result = platform_file_manager_compare_filename(data.entries[middle].filename, filename);
+        if (result == 0) {
+            return &data.entries[middle];
+        } else if (result < 0) {
+            left = middle + 1;
+        } else {
+            right = middle - 1;
+        }
+    }
+    return 0;
+}
+
+static int read_info(const char *filename, int check_only, long long *modified, saved_game_info *info)
+{
+    int size;
+    long long new_modified;
+    if (!platform_file_manager_get_file_stats(filename, &size, &new_modified)) {
+        return ENTRY_FAILED;
+    }
+    // saves of the same format often have the same size: the modification time tells them apart
+    if (check_only && size == info->file_size && new_modified == *modified) {
+        return ENTRY_READY;
+    }
+    *modified = new_modified;
+    return game_file_io_read_saved_game_info(filename, info) ? ENTRY_READY : ENTRY_FAILED;
+}
+
+static void store_result(index_entry *entry, int state, long long modified, const saved_game_info *info)
+{
+    entry->state = state;
+    entry->has_info = state == ENTRY_READY;
+    if (entry->has_info) {
+        entry->modified = modified;
+        entry->info = *info;
+    }
+}
+
+static int worker_loop(void *unused)
+{
+    char filename[FILE_NAME_MAX];
+    long long modified;
+    saved_game_info info;
+    thread_mutex_lock(data.mutex);
+    while (!data.quit) {
+        index_entry *entry = 0;
+        for (int i = 0; i < data.num_entries; i++) {
+            if (data.entries[i].state == ENTRY_NEEDS_READ || data.entries[i].state == ENTRY_NEEDS_CHECK) {
+                entry = &data.entries[i];
+                break;
+            }
+        }
+        if (!entry) {
+            thread_condition_wait(data.work_available, data.mutex);
+            continue;
+        }
+        int check_only = entry->state == ENTRY_NEEDS_CHECK;
+        strcpy(filename, entry->filename);
+        modified = entry->modified;
+        info = entry->info;
+        entry->state = ENTRY_IN_PROGRESS;
+
+        thread_mutex_unlock(data.mutex);
+        int state = read_info(filename, check_only, &modified, &info);
+        thread_mutex_lock(data.mutex);
+
+        // The listing may have changed while reading: only store the result if the entry still wants it
+        entry = find_entry(filename);
+        if (entry && entry->state == ENTRY_IN_PROGRESS) {
+            store_result(entry, state, modified, &info);
+        }
+    }
+    thread_mutex_unlock(data.mutex);
+    return 0;
+}
+
+static void start_worker(void)
+{
+    if (data.started) {
+        return;
+    }
+    data.started = 1;
+    data.mutex = thread_mutex_create();
+    data.work_available = thread_condition_create();
+    if (data.mutex && data.work_available) {
+        data.quit = 0;
+        data.worker = thread_create(worker_loop, "saved game index", 0);
+        if (data.worker) {
+            return;
+        }
+    }
+    // Without a background thread, summaries are read on demand
+    if (data.work_available) {
+        thread_condition_destroy(data.work_available);
+        data.work_available = 0;
+    }
+    if (data.mutex) {
+        thread_mutex_destroy(data.mutex);
+        data.mutex = 0;
+    }
+}
+
+static void queue_work(void)
+{
+    if (data.worker) {
+        thread_condition_signal(data.work_available);
+    }
+}
+
+void saved_game_index_update(const dir_listing *files)
+{
+    start_worker();
+    index_entry *entries = (index_entry *) malloc(sizeof(index_entry) * (files->num_files ? files->num_files : 1));
+    if (!entries) {
+        return;
+    }
+    lock();
+    // Both lists are sorted by filename, so known entries can be merged in one pass
+    int old = 0;
+    for (int i = 0; i < files->num_files; i++) {
+        index_entry *entry = &entries[i];
+        while (old < data.num_entries &&
+            platform_file_manager_compare_filename(data.entries[old].filename, files->files[i]) < 0) {
+            old++;
+        }
+        if (old < data.num_entries &&
+            platform_file_manager_compare_filename(data.entries[old].filename, files->files[i]) == 0) {
+            *entry = data.entries[old++];
+            if (entry->state == ENTRY_READY) {
+                entry->state = ENTRY_NEEDS_CHECK;
+            } else if (entry->state == ENTRY_FAILED) {
+                entry->state = ENTRY_NEEDS_READ;
+            }
+        } else {
+            memset(entry, 0, sizeof(index_entry));
+            entry->state = ENTRY_NEEDS_READ;
+        }
+        strncpy(entry->filename, files->files[i], FILE_NAME_MAX - 1);
+        entry->filename[FILE_NAME_MAX - 1] = 0;
+    }
+    free(data.entries);
+    data.entries = entries;
+    data.num_entries = files->num_files;
+    queue_work();
+    unlock();
+}
+
+int saved_game_index_get(const char *filename, saved_game_info *info)
+{
+    lock();
+    index_entry *entry = find_entry(filename);
+    if (entry && !data.worker && entry->state != ENTRY_READY && entry->state != ENTRY_FAILED) {
+        // No background thread: read the summary now, which only happens for files that are shown
+        long long modified = entry->modified;
+        saved_game_info new_info = entry->info;
+        int state = read_info(entry->filename, entry->state == ENTRY_NEEDS_CHECK, &modified, &new_info);
+        store_result(entry, state, modified, &new_info);
+    }
+    int has_info = entry && entry->has_info;
+    if (has_info) {
+        *info = entry->info;
+    }
+    unlock();
+    return has_info;
+}
+
+void saved_game_index_invalidate(const char *filename)
+{
+    lock();
+    index_entry *entry = find_entry(filename);
+    if (entry) {
+        entry->state = ENTRY_NEEDS_READ;
+        entry->has_info = 0;
+        queue_work();
+    }
+    unlock();
+}
+
+void saved_game_index_shutdown(void)
+{
+    if (data.worker) {
+        thread_mutex_lock(data.mutex);
+        data.quit = 1;
+        thread_condition_broadcast(data.work_available);
+        thread_mutex_unlock(data.mutex);
+        thread_wait(data.worker);
+        data.worker = 0;
+        thread_condition_destroy(data.work_available);
+        thread_mutex_destroy(data.mutex);
+        data.work_available = 0;
+        data.mutex = 0;
+    }
+    data.started = 0;
+    free(data.entries);
+    data.entries = 0;
+    data.num_entries = 0;
+}
@@ -0,0 +1,40 @@
+#ifndef GAME_SAVED_GAME_INDEX_H
+#define GAME_SAVED_GAME_INDEX_H
+
+#include "core/dir.h"
+#include "game/file_io.h"
+
+/**
+ * @file
+ * In-memory index of saved game summaries for the file dialog.
+ * Summaries are read on a background thread when one is available,
+ * otherwise they are read on demand.
+ */
+
+/**
+ * Synchronizes the index with a directory listing of saved games.
+ * New files are queued for reading, files that are known are rechecked.
+ * @param files Listing of saved games, sorted by filename
+ */
+void saved_game_index_update(const dir_listing *files);
+
+/**
+ * Gets the summary of a saved game
+ * @param filename Filename as it appears in the listing
+ * @param info Summary to fill in
+ * @return Boolean true if the summary is available, false if it is not (yet) known
+ */
+int saved_game_index_get(const char *filename, saved_game_info *info);
+
+/**
+ * Marks a saved game as changed, so its summary is read again
+ * @param filename Filename of the saved game
+ */
+void saved_game_index_invalidate(const char *filename);
+
+/**
+ * Stops the background thread and clears the index
+ */
+void saved_game_index_shutdown(void);
+
+#endif // GAME_SAVED_GAME_INDEX_H
@@ -99,7 +99,7 @@ static void advance_month(void)
     city_festival_update();
     tutorial_on_month_tick();
     if (setting_monthly_autosave()) {
-        game_file_write_saved_game("autosave.sav");
+        game_file_write_autosave();
     }
 }
 
@@ -121,7 +121,7 @@ static void advance_tick(void)
     switch (game_time_tick()) {
         case 1: city_gods_calculate_moods(1); break;
         case 2: sound_music_update(0); break;
-        case 3: widget_minimap_invalidate(); break;
+        case 3: widget_minimap_update(); break;
         case 4: city_emperor_update(); break;
         case 5: formation_update_all(0); break;
         case 6: map_natives_check_land(); break;
@@ -142,7 +142,7 @@ static void advance_tick(void)
         case 27: map_water_supply_update_reservoir_fountain(); break;
         case 28: map_water_supply_update_houses(); break;
         case 29: formation_update_all(1); break;
-        case 30: widget_minimap_invalidate(); break;
+        case 30: widget_minimap_update(); break;
         case 31: building_figure_generate(); break;
         case 32: city_trade_update(); break;
         case 33: building_count_update(); city_culture_update_coverage(); break;
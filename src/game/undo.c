@@ -31,6 +31,7 @@ static struct {
     int num_buildings;
     building_type type;
     building buildings[MAX_UNDO_BUILDINGS];
+    uint8_t is_on_list[MAX_BUILDINGS];
 } data;
 
 int game_can_undo(void)
@@ -48,26 +49,15 @@ void game_undo_add_building(building *b)
     if (b->id <= 0) {
         return;
     }
-    data.num_buildings = 0;
-    int is_on_list = 0;
-    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
-        if (data.buildings[i].id) {
-            data.num_buildings++;
-        }
-        if (data.buildings[i].id == b->id) {
-            is_on_list = 1;
-        }
+    if (data.is_on_list[b->id]) {
+        return;
     }
-    if (!is_on_list) {
-        for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
-            if (!data.buildings[i].id) {
-                data.num_buildings++;
-                memcpy(&data.buildings[i], b, sizeof(building));
-                return;
-            }
-        }
+    if (data.num_buildings >= MAX_UNDO_BUILDINGS) {
         data.available = 0;
+        return;
     }
+    memcpy(&data.buildings[data.num_buildings++], b, sizeof(building));
+    data.is_on_list[b->id] = 1;
 }
 
 int game_undo_contains_building(int building_id)
@@ -75,19 +65,14 @@ int game_undo_contains_building(int building_id)
     if (building_id <= 0 || !game_can_undo()) {
         return 0;
     }
-    if (data.num_buildings <= 0) {
-        return 0;
-    }
-    for (int i = 0; i < MAX_UNDO_BUILDINGS; i++) {
-        if (data.buildings[i].id == building_id) {
-            return 1;
-        }
-    }
-    return 0;
+    return data.is_on_list[building_id];
 }
 
 static void clear_buildings(void)
 {
+    for (int i = 0; i < data.num_buildings; i++) {
+        data.is_on_list[data.buildings[i].id] = 0;
+    }
     data.num_buildings = 0;
     memset(data.buildings, 0, MAX_UNDO_BUILDINGS * sizeof(building));
 }
@@ -134,20 +119,6 @@ void game_undo_restore_building_state(void)
     clear_buildings();
 }
 
-static void restore_map_images(void)
-{
-    int map_width, map_height;
-    map_grid_size(&map_width, &map_height);
-    for (int y = 0; y < map_height; y++) {
-        for (int x = 0; x < map_width; x++) {
-            int grid_offset = map_grid_offset(x, y);
-            if (!map_building_at(grid_offset)) {
-                map_image_restore_at(grid_offset);
-            }
-        }
-    }
-}
-
 void game_undo_restore_map(int include_properties)
 {
     map_terrain_restore();
@@ -155,7 +126,18 @@ void game_undo_restore_map(int include_properties)
     if (include_properties) {
         map_property_restore();
     }
-    restore_map_images();
+    map_image_restore_without_building();
+}
+
+int game_undo_get_changed_area(int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    *x_min = *y_min = GRID_SIZE;
+    *x_max = *y_max = -1;
+    map_terrain_extend_changed_area(x_min, y_min, x_max, y_max);
+    map_aqueduct_extend_changed_area(x_min, y_min, x_max, y_max);
+    map_image_extend_changed_area(x_min, y_min, x_max, y_max);
+    map_property_extend_changed_area(x_min, y_min, x_max, y_max);
+    return *x_max >= 0;
 }
 
 void game_undo_finish_build(int cost)
@@ -209,6 +191,7 @@ void game_undo_perform(void)
             if (data.buildings[i].id) {
                 building *b = building_get(data.buildings[i].id);
                 memcpy(b, &data.buildings[i], sizeof(building));
+                building_update_house_index(b);
                 if (b->type == BUILDING_WAREHOUSE || b->type == BUILDING_GRANARY) {
                     if (!building_storage_restore(b->storage_id)) {
                         building_storage_reset_building_ids();
@@ -227,21 +210,21 @@ void game_undo_perform(void)
             data.type == BUILDING_WALL) {
         map_terrain_restore();
         map_aqueduct_restore();
-        restore_map_images();
+        map_image_restore_without_building();
     } else if (data.type == BUILDING_LOW_BRIDGE || data.type == BUILDING_SHIP_BRIDGE) {
         map_terrain_restore();
         map_sprite_restore();
-        restore_map_images();
+        map_image_restore_without_building();
     } else if (data.type == BUILDING_PLAZA || data.type == BUILDING_GARDENS) {
         map_terrain_restore();
         map_aqueduct_restore();
         map_property_restore();
-        restore_map_images();
+        map_image_restore_without_building();
     } else if (data.num_buildings) {
         if (data.type == BUILDING_DRAGGABLE_RESERVOIR) {
             map_terrain_restore();
             map_aqueduct_restore();
-            restore_map_images();
+            map_image_restore_without_building();
         }
         for (int i = 0; i < data.num_buildings; i++) {
             if (data.buildings[i].id) {
@@ -256,7 +239,7 @@ void game_undo_perform(void)
     }
     map_routing_update_land();
     map_routing_update_walls();
-    data.num_buildings = 0;
+    clear_buildings();
 }
 
 void game_undo_reduce_time_available(void)
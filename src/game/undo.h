@@ -15,6 +15,12 @@ void game_undo_restore_building_state(void);
 
 void game_undo_restore_map(int include_properties);
 
+/**
+ * Gets the area containing all map tiles changed since the start of the build
+ * @return 1 if any tile changed, 0 otherwise
+ */
+int game_undo_get_changed_area(int *x_min, int *y_min, int *x_max, int *y_max);
+
 int game_undo_start_build(building_type type);
 
 void game_undo_finish_build(int cost);
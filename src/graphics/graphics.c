@@ -1,18 +1,22 @@
 #include "graphics.h"
 
+#include "core/thread.h"
 #include "game/system.h"
 #include "graphics/screen.h"
 
 #include <stdlib.h>
 #include <string.h>
 
+#define MAX_DIRTY_RECTS 16
+
 static struct {
     color_t *pixels;
     int width;
     int height;
 } canvas;
 
-static struct {
+// Clip state is per thread, so worker threads can draw into separate parts of the canvas
+static THREAD_LOCAL struct {
     int x_start;
     int x_end;
     int y_start;
@@ -24,7 +28,22 @@ static struct {
     int y;
 } translation;
 
-static clip_info clip;
+static THREAD_LOCAL clip_info clip;
+
+static THREAD_LOCAL int damage_tracking_disabled;
+
+typedef struct {
+    int x_start;
+    int x_end;
+    int y_start;
+    int y_end;
+} dirty_rect;
+
+static struct {
+    dirty_rect rects[MAX_DIRTY_RECTS];
+    int num_rects;
+    int all_dirty;
+} damage;
 
 void graphics_init_canvas(int width, int height)
 {
@@ -34,6 +53,7 @@ void graphics_init_canvas(int width, int height)
     canvas.height = height;
 
     graphics_set_clip_rectangle(0, 0, width, height);
+    graphics_mark_all_dirty();
 }
 
 const void *graphics_canvas(void)
@@ -89,6 +109,14 @@ void graphics_set_clip_rectangle(int x, int y, int width, int height)
     }
 }
 
+void graphics_get_clip_rectangle(int *x, int *y, int *width, int *height)
+{
+    *x = clip_rectangle.x_start;
+    *y = clip_rectangle.y_start;
+    *width = clip_rectangle.x_end - clip_rectangle.x_start;
+    *height = clip_rectangle.y_end - clip_rectangle.y_start;
+}
+
 void graphics_reset_clip_rectangle(void)
 {
     clip_rectangle.x_start = 0;
@@ -186,6 +214,7 @@ void graphics_draw_from_buffer(int x, int y, int width, int height, const color_
     if (!current_clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x, y, width, height);
     int min_x = x + current_clip->clipped_pixels_left;
     int min_dy = current_clip->clipped_pixels_top;
     int max_dy = height - current_clip->clipped_pixels_bottom;
@@ -195,6 +224,110 @@ void graphics_draw_from_buffer(int x, int y, int width, int height, const color_
     }
 }
 
+static int rect_area(const dirty_rect *r)
+{
+    return (r->x_end - r->x_start) * (r->y_end - r->y_start);
+}
+
+static void rect_union(dirty_rect *dst, const dirty_rect *src)
+{
+    if (src->x_start < dst->x_start) {
+        dst->x_start = src->x_start;
+    }
+    if (src->x_end > dst->x_end) {
+        dst->x_end = src->x_end;
+    }
+    if (src->y_start < dst->y_start) {
+        dst->y_start = src->y_start;
+    }
+    if (src->y_end > dst->y_end) {
+        dst->y_end = src->y_end;
+    }
+}
+
+static int rects_touch(const dirty_rect *a, const dirty_rect *b)
+{
+    return a->x_start <= b->x_end && b->x_start <= a->x_end &&
+        a->y_start <= b->y_end && b->y_start <= a->y_end;
+}
+
+static void add_dirty_rect(const dirty_rect *r)
+{
+    for (int i = 0; i < damage.num_rects; i++) {
+        if (rects_touch(&damage.rects[i], r)) {
+            rect_union(&damage.rects[i], r);
+            return;
+        }
+    }
+    if (damage.num_rects < MAX_DIRTY_RECTS) {
+        damage.rects[damage.num_rects++] = *r;
+        return;
+    }
+    // List is full: grow the rectangle that needs the fewest extra pixels
+    int best_index = 0;
+    int best_growth = -1;
+    for (int i = 0; i < damage.num_rects; i++) {
+        dirty_rect merged = damage.rects[i];
+        rect_union(&merged, r);
+        int growth = rect_area(&merged) - rect_area(&damage.rects[i]);
+        if (best_growth < 0 || growth < best_growth) {
+            best_growth = growth;
+            best_index = i;
+        }
+    }
+    rect_union(&damage.rects[best_index], r);
+}
+
+void graphics_mark_dirty(int x, int y, int width, int height)
+{
+    if (damage.all_dirty || damage_tracking_disabled) {
+        return;
+    }
+    dirty_rect r = {
+        x < clip_rectangle.x_start ? clip_rectangle.x_start : x,
+        x + width > clip_rectangle.x_end ? clip_rectangle.x_end : x + width,
+        y < clip_rectangle.y_start ? clip_rectangle.y_start : y,
+        y + height > clip_rectangle.y_end ? clip_rectangle.y_end : y + height
+    };
+    if (r.x_start >= r.x_end || r.y_start >= r.y_end) {
+        return;
+    }
+    r.x_start += translation.x;
+    r.x_end += translation.x;
+    r.y_start += translation.y;
+    r.y_end += translation.y;
+    add_dirty_rect(&r);
+}
+
+void graphics_set_damage_tracking(int enabled)
+{
+    damage_tracking_disabled = !enabled;
+}
+
+void graphics_mark_all_dirty(void)
+{
+    damage.all_dirty = 1;
+    damage.num_rects = 0;
+}
+
+void graphics_foreach_dirty_rect(void (*callback)(int x, int y, int width, int height))
+{
+    if (damage.all_dirty) {
+        callback(0, 0, canvas.width, canvas.height);
+        return;
+    }
+    for (int i = 0; i < damage.num_rects; i++) {
+        const dirty_rect *r = &damage.rects[i];
+        callback(r->x_start, r->y_start, r->x_end - r->x_start, r->y_end - r->y_start);
+    }
+}
+
+void graphics_clear_dirty_rects(void)
+{
+    damage.all_dirty = 0;
+    damage.num_rects = 0;
+}
+
 color_t *graphics_get_pixel(int x, int y)
 {
     return &canvas.pixels[(translation.y + y) * canvas.width + (translation.x + x)];
@@ -203,6 +336,7 @@ color_t *graphics_get_pixel(int x, int y)
 void graphics_clear_screen(void)
 {
     memset(canvas.pixels, 0, sizeof(color_t) * canvas.width * canvas.height);
+    graphics_mark_all_dirty();
 }
 
 void graphics_draw_vertical_line(int x, int y1, int y2, color_t color)
@@ -214,6 +348,7 @@ void graphics_draw_vertical_line(int x, int y1, int y2, color_t color)
     int y_max = y1 < y2 ? y2 : y1;
     y_min = y_min < clip_rectangle.y_start ? clip_rectangle.y_start : y_min;
     y_max = y_max >= clip_rectangle.y_end ? clip_rectangle.y_end - 1 : y_max;
+    graphics_mark_dirty(x, y_min, 1, y_max - y_min + 1);
     color_t *pixel = graphics_get_pixel(x, y_min);
     color_t *end_pixel = pixel + ((y_max - y_min) * canvas.width);
     while (pixel <= end_pixel) {
@@ -231,6 +366,7 @@ void graphics_draw_horizontal_line(int x1, int x2, int y, color_t color)
     int x_max = x1 < x2 ? x2 : x1;
     x_min = x_min < clip_rectangle.x_start ? clip_rectangle.x_start : x_min;
     x_max = x_max >= clip_rectangle.x_end ? clip_rectangle.x_end - 1 : x_max;
+    graphics_mark_dirty(x_min, y, x_max - x_min + 1, 1);
     color_t *pixel = graphics_get_pixel(x_min, y);
     color_t *end_pixel = pixel + (x_max - x_min);
     while (pixel <= end_pixel) {
@@ -268,6 +404,7 @@ void graphics_shade_rect(int x, int y, int width, int height, int darkness)
     if (!cur_clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x, y, width, height);
     for (int yy = y + cur_clip->clipped_pixels_top; yy < y + height - cur_clip->clipped_pixels_bottom; yy++) {
         for (int xx = x + cur_clip->clipped_pixels_left; xx < x + width - cur_clip->clipped_pixels_right; xx++) {
             color_t *pixel = graphics_get_pixel(xx, yy);
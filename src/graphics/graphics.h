@@ -33,6 +33,7 @@ void graphics_reset_dialog(void);
 
 void graphics_set_clip_rectangle(int x, int y, int width, int height);
 void graphics_reset_clip_rectangle(void);
+void graphics_get_clip_rectangle(int *x, int *y, int *width, int *height);
 const clip_info *graphics_get_clip_info(int x, int y, int width, int height);
 
 void graphics_save_to_buffer(int x, int y, int width, int height, color_t *buffer);
@@ -40,6 +41,22 @@ void graphics_draw_from_buffer(int x, int y, int width, int height, const color_
 
 color_t *graphics_get_pixel(int x, int y);
 
+/**
+ * Marks an area of the canvas as changed, so it gets uploaded to the screen on the next update.
+ * Coordinates are relative to the current translation and the area is clipped to the clip rectangle.
+ * Anything drawing through graphics_get_pixel() must call this for the area it touches.
+ */
+void graphics_mark_dirty(int x, int y, int width, int height);
+void graphics_mark_all_dirty(void);
+
+/**
+ * Enables or disables damage tracking for the calling thread.
+ * Worker threads must disable it and draw only into areas already marked as dirty.
+ */
+void graphics_set_damage_tracking(int enabled);
+void graphics_foreach_dirty_rect(void (*callback)(int x, int y, int width, int height));
+void graphics_clear_dirty_rects(void);
+
 void graphics_clear_screen(void);
 
 void graphics_draw_vertical_line(int x, int y1, int y2, color_t color);
@@ -38,6 +38,7 @@ static void draw_uncompressed(
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, img->width, img->height);
     data += img->width * clip->clipped_pixels_top;
     for (int y = clip->clipped_pixels_top; y < img->height - clip->clipped_pixels_bottom; y++) {
         data += clip->clipped_pixels_left;
@@ -102,6 +103,7 @@ static void draw_compressed(const image *img, const color_t *data, int x_offset,
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, img->width, height);
     int unclipped = clip->clip_x == CLIP_NONE;
 
     for (int y = 0; y < height - clip->clipped_pixels_bottom; y++) {
@@ -147,6 +149,7 @@ static void draw_compressed_set(
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, img->width, height);
     int unclipped = clip->clip_x == CLIP_NONE;
 
     for (int y = 0; y < height - clip->clipped_pixels_bottom; y++) {
@@ -193,6 +196,7 @@ static void draw_compressed_and(
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, img->width, height);
     int unclipped = clip->clip_x == CLIP_NONE;
 
     for (int y = 0; y < height - clip->clipped_pixels_bottom; y++) {
@@ -243,6 +247,7 @@ static void draw_compressed_blend(
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, img->width, height);
     int unclipped = clip->clip_x == CLIP_NONE;
 
     for (int y = 0; y < height - clip->clipped_pixels_bottom; y++) {
@@ -289,6 +294,7 @@ static void draw_compressed_blend_alpha(
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, img->width, height);
     color_t alpha = COMPONENT(color, 24);
     if (!alpha) {
         return;
@@ -388,6 +394,7 @@ static void draw_footprint_tile(const color_t *data, int x_offset, int y_offset,
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, FOOTPRINT_WIDTH, FOOTPRINT_HEIGHT);
     // If the current tile neither clipped nor color masked, just draw it normally
     if (clip->clip_y == CLIP_NONE && clip->clip_x == CLIP_NONE && color_mask == COLOR_MASK_NONE) {
         draw_footprint_simple(data, x_offset, y_offset);
@@ -898,6 +905,7 @@ void image_draw_scaled_down(int image_id, int x_offset, int y_offset, unsigned i
     if (!clip->is_visible) {
         return;
     }
+    graphics_mark_dirty(x_offset, y_offset, width, height);
     for (int y = clip->clipped_pixels_top; y < height - clip->clipped_pixels_bottom; y++) {
         color_t *dst = graphics_get_pixel(x_offset + clip->clipped_pixels_left, y_offset + y);
         int x_max = width - clip->clipped_pixels_right;
@@ -7,6 +7,7 @@
 #include "core/file.h"
 #include "core/log.h"
 #include "core/string.h"
+#include "core/thread.h"
 #include "graphics/screen.h"
 #include "graphics/graphics.h"
 #include "graphics/menu.h"
@@ -26,6 +27,7 @@
 #define TILE_Y_SIZE 30
 #define IMAGE_HEIGHT_CHUNK TILE_Y_SIZE
 #define IMAGE_BYTES_PER_PIXEL 3
+#define MAX_QUEUED_CHUNKS 4
 
 enum {
     FULL_CITY_SCREENSHOT = 0,
@@ -51,6 +53,19 @@ static struct {
     png_infop info_ptr;
 } image;
 
+// Chunks of converted rows waiting to be compressed by the writer thread
+static struct {
+    uint8_t *buffers[MAX_QUEUED_CHUNKS];
+    int first;
+    int count;
+    int done;
+    int error;
+    thread *writer;
+    thread_mutex *mutex;
+    thread_condition *chunk_added;
+    thread_condition *chunk_written;
+} queue;
+
 static void image_free(void)
 {
     image.width = 0;
@@ -142,25 +157,164 @@ static int image_request_rows(void)
     return 0;
 }
 
+static void convert_row(const color_t *canvas_row, uint8_t *pixel)
+{
+    for (int x = 0; x < image.width; x++) {
+        color_t input = canvas_row[x];
+        *(pixel + 0) = (uint8_t) ((input & 0xff0000) >> 16);
+        *(pixel + 1) = (uint8_t) ((input & 0x00ff00) >> 8);
+        *(pixel + 2) = (uint8_t) ((input & 0x0000ff) >> 0);
+        pixel += 3;
+    }
+}
+
 static int image_write_rows(const color_t *canvas, int canvas_width)
 {
     if (setjmp(png_jmpbuf(image.png_ptr))) {
         return 0;
     }
     for (int y = 0; y < image.rows_in_memory; ++y) {
-        uint8_t *pixel = image.pixels;
-        for (int x = 0; x < image.width; x++) {
-            color_t input = canvas[y * canvas_width + x];
-            *(pixel + 0) = (uint8_t) ((input & 0xff0000) >> 16);
-            *(pixel + 1) = (uint8_t) ((input & 0x00ff00) >> 8);
-            *(pixel + 2) = (uint8_t) ((input & 0x0000ff) >> 0);
-            pixel += 3;
-        }
+        convert_row(&canvas[y * canvas_width], image.pixels);
         png_write_row(image.png_ptr, image.pixels);
     }
     return 1;
 }
 
+static void image_convert_chunk(const color_t *canvas, int canvas_width, uint8_t *chunk)
+{
+    for (int y = 0; y < image.rows_in_memory; ++y) {
+        convert_row(&canvas[y * canvas_width], &chunk[y * image.row_size]);
+    }
+}
+
+static int image_write_chunk(uint8_t *chunk)
+{
+    if (setjmp(png_jmpbuf(image.png_ptr))) {
+        return 0;
+    }
+    for (int y = 0; y < image.rows_in_memory; ++y) {
+        png_write_row(image.png_ptr, &chunk[y * image.row_size]);
+    }
+    return 1;
+}
+
+static int write_queued_chunks(void *unused)
+{
+    thread_mutex_lock(queue.mutex);
+    while (1) {
+        while (!queue.count && !queue.done) {
+            thread_condition_wait(queue.chunk_added, queue.mutex);
+        }
+        if (!queue.count) {
+            break;
+        }
+        uint8_t *chunk = queue.buffers[queue.first];
+        int error = queue.error;
+        thread_mutex_unlock(queue.mutex);
+        if (!error && !image_write_chunk(chunk)) {
+            error = 1;
+        }
+        thread_mutex_lock(queue.mutex);
+        queue.error |= error;
+        queue.first = (queue.first + 1) % MAX_QUEUED_CHUNKS;
+        queue.count--;
+        thread_condition_signal(queue.chunk_written);
+    }
+    thread_mutex_unlock(queue.mutex);
+    return 0;
+}
+
+static void stop_writer(void)
+{
+    if (!queue.writer) {
+        return;
+    }
+    thread_mutex_lock(queue.mutex);
+    queue.done = 1;
+    thread_condition_signal(queue.chunk_added);
+    thread_mutex_unlock(queue.mutex);
+    thread_wait(queue.writer);
+    queue.writer = 0;
+}
+
+static void queue_free(void)
+{
+    stop_writer();
+    if (queue.chunk_written) {
+        thread_condition_destroy(queue.chunk_written);
+        queue.chunk_written = 0;
+    }
+    if (queue.chunk_added) {
+        thread_condition_destroy(queue.chunk_added);
+        queue.chunk_added = 0;
+    }
+    if (queue.mutex) {
+        thread_mutex_destroy(queue.mutex);
+        queue.mutex = 0;
+    }
+    for (int i = 0; i < MAX_QUEUED_CHUNKS; i++) {
+        free(queue.buffers[i]);
+        queue.buffers[i] = 0;
+    }
+}
+
+static int queue_create(void)
+{
+    queue_free();
+    queue.first = 0;
+    queue.count = 0;
+    queue.done = 0;
+    queue.error = 0;
+    for (int i = 0; i < MAX_QUEUED_CHUNKS; i++) {
+        queue.buffers[i] = (uint8_t *) malloc((size_t) image.row_size * image.rows_in_memory);
+        if (!queue.buffers[i]) {
+            queue_free();
+            return 0;
+        }
+    }
+    queue.mutex = thread_mutex_create();
+    queue.chunk_added = thread_condition_create();
+    queue.chunk_written = thread_condition_create();
+    if (queue.mutex && queue.chunk_added && queue.chunk_written) {
+        queue.writer = thread_create(write_queued_chunks, "screenshot", 0);
+    }
+    // Without a writer thread, chunks are compressed on the calling thread
+    return 1;
+}
+
+static uint8_t *queue_get_free_chunk(void)
+{
+    if (!queue.writer) {
+        return queue.buffers[0];
+    }
+    thread_mutex_lock(queue.mutex);
+    while (queue.count == MAX_QUEUED_CHUNKS) {
+        thread_condition_wait(queue.chunk_written, queue.mutex);
+    }
+    uint8_t *chunk = queue.buffers[(queue.first + queue.count) % MAX_QUEUED_CHUNKS];
+    thread_mutex_unlock(queue.mutex);
+    return chunk;
+}
+
+static int queue_add_chunk(uint8_t *chunk)
+{
+    if (!queue.writer) {
+        return image_write_chunk(chunk);
+    }
+    thread_mutex_lock(queue.mutex);
+    queue.count++;
+    thread_condition_signal(queue.chunk_added);
+    int error = queue.error;
+    thread_mutex_unlock(queue.mutex);
+    return !error;
+}
+
+static int queue_finish(void)
+{
+    stop_writer();
+    return !queue.error;
+}
+
 static int image_write_canvas(void)
 {
     const color_t *canvas = graphics_canvas();
@@ -220,11 +374,8 @@ static void create_window_screenshot(void)
     image_free();
 }
 
-static void create_full_city_screenshot(void)
+int graphics_save_full_city_screenshot(const char *filename)
 {
-    if (!window_is(WINDOW_CITY) && !window_is(WINDOW_CITY_MILITARY)) {
-        return;
-    }
     pixel_offset original_camera_pixels;
     city_view_get_camera_in_pixels(&original_camera_pixels.x, &original_camera_pixels.y);
     int width = screen_width();
@@ -233,15 +384,17 @@ static void create_full_city_screenshot(void)
     int city_width_pixels = map_grid_width() * TILE_X_SIZE;
     int city_height_pixels = map_grid_height() * TILE_Y_SIZE;
 
-    if (!image_create(city_width_pixels, city_height_pixels + TILE_Y_SIZE, IMAGE_HEIGHT_CHUNK)) {
+    if (!image_create(city_width_pixels, city_height_pixels + TILE_Y_SIZE, IMAGE_HEIGHT_CHUNK) ||
+        !queue_create()) {
         log_error("Unable to set memory for full city screenshot", 0, 0);
-        return;
+        image_free();
+        return 0;
     }
-    const char *filename = generate_filename(FULL_CITY_SCREENSHOT);
     if (!image_begin_io(filename) || !image_write_header()) {
         log_error("Unable to write screenshot to:", filename, 0);
+        queue_free();
         image_free();
-        return;
+        return 0;
     }
 
     int canvas_width = city_width_pixels + (city_view_is_sidebar_collapsed() ? 40 : 160);
@@ -257,24 +410,45 @@ static void create_full_city_screenshot(void)
     int size;
     const color_t *canvas = (color_t *) graphics_canvas() + TOP_MENU_HEIGHT * canvas_width;
     while ((size = image_request_rows())) {
+        // The writer thread compresses previous chunks while the next one is drawn
         city_view_set_camera_from_pixel_position(base_width, current_height);
         city_without_overlay_draw(0, 0, &dummy_tile);
-        if (!image_write_rows(canvas, canvas_width)) {
-            log_error("Error writing image", 0, 0);
+        uint8_t *chunk = queue_get_free_chunk();
+        image_convert_chunk(canvas, canvas_width, chunk);
+        if (!queue_add_chunk(chunk)) {
             error = 1;
             break;
         }
         current_height += size;
     }
+    if (!queue_finish()) {
+        error = 1;
+    }
+    queue_free();
     graphics_reset_clip_rectangle();
-    screen_set_resolution(width, height);
+    if (width && height) {
+        screen_set_resolution(width, height);
+    }
     city_view_set_camera_from_pixel_position(original_camera_pixels.x, original_camera_pixels.y);
-    if (!error) {
+    if (error) {
+        log_error("Error writing image", 0, 0);
+    } else {
         image_finish();
         log_info("Saved full city screenshot:", filename, 0);
-        show_saved_notice(filename);
     }
     image_free();
+    return !error;
+}
+
+static void create_full_city_screenshot(void)
+{
+    if (!window_is(WINDOW_CITY) && !window_is(WINDOW_CITY_MILITARY)) {
+        return;
+    }
+    const char *filename = generate_filename(FULL_CITY_SCREENSHOT);
+    if (graphics_save_full_city_screenshot(filename)) {
+        show_saved_notice(filename);
+    }
 }
 
 void graphics_save_screenshot(int full_city)
@@ -3,4 +3,11 @@
 
 void graphics_save_screenshot(int full_city);
 
+/**
+ * Renders the whole city to a PNG file, without changing the current window
+ * @param filename File to write to
+ * @return 1 on success, 0 on failure
+ */
+int graphics_save_full_city_screenshot(const char *filename);
+
 #endif // GRAPHICS_SCREENSHOT_H
@@ -3,6 +3,7 @@
 #include "core/dir.h"
 #include "core/file.h"
 #include "core/smacker.h"
+#include "core/thread.h"
 #include "core/time.h"
 #include "game/settings.h"
 #include "graphics/graphics.h"
@@ -11,6 +12,20 @@
 #include "sound/music.h"
 #include "sound/speech.h"
 
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_QUEUED_FRAMES 4
+#define PALETTE_SIZE 256
+
+typedef struct {
+    uint8_t *video;
+    color_t palette[PALETTE_SIZE];
+    uint8_t *audio;
+    int audio_len;
+    int audio_capacity;
+} video_frame;
+
 static struct {
     int is_playing;
     int is_ended;
@@ -31,15 +46,172 @@ static struct {
         int rate;
     } audio;
 
+    // Frames decoded ahead of playback: the first one is the frame being shown
+    struct {
+        video_frame frames[MAX_QUEUED_FRAMES];
+        int frame_size;
+        int first;
+        int count;
+        int finished;
+        int quit;
+        thread *decoder;
+        thread_mutex *mutex;
+        thread_condition *frame_decoded;
+        thread_condition *frame_released;
+    } queue;
+
     int restart_music;
 } data;
 
+static int store_frame(video_frame *frame)
+{
+    const uint8_t *video = smacker_get_frame_video(data.s);
+    const color_t *palette = smacker_get_frame_palette(data.s);
+    if (!video || !palette) {
+        return 0;
+    }
+    memcpy(frame->video, video, data.queue.frame_size);
+    memcpy(frame->palette, palette, sizeof(color_t) * PALETTE_SIZE);
+    frame->audio_len = 0;
+    if (data.audio.has_audio) {
+        int audio_len = smacker_get_frame_audio_size(data.s, 0);
+        if (audio_len > frame->audio_capacity) {
+            uint8_t *audio = (uint8_t *) realloc(frame->audio, audio_len);
+            if (!audio) {
+                return 0;
+            }
+            frame->audio = audio;
+            frame->audio_capacity = audio_len;
+        }
+        if (audio_len > 0) {
+            memcpy(frame->audio, smacker_get_frame_audio(data.s, 0), audio_len);
+            frame->audio_len = audio_len;
+        }
+    }
+    return 1;
+}
+
+static int decode_frames(void *unused)
+{
+    thread_mutex_lock(data.queue.mutex);
+    while (1) {
+        while (data.queue.count == MAX_QUEUED_FRAMES && !data.queue.quit) {
+            thread_condition_wait(data.queue.frame_released, data.queue.mutex);
+        }
+        if (data.queue.quit) {
+            break;
+        }
+        video_frame *frame = &data.queue.frames[(data.queue.first + data.queue.count) % MAX_QUEUED_FRAMES];
+        thread_mutex_unlock(data.queue.mutex);
+        int ok = smacker_next_frame(data.s) == SMACKER_FRAME_OK && store_frame(frame);
+        thread_mutex_lock(data.queue.mutex);
+        if (!ok) {
+            data.queue.finished = 1;
+            thread_condition_signal(data.queue.frame_decoded);
+            break;
+        }
+        data.queue.count++;
+        thread_condition_signal(data.queue.frame_decoded);
+    }
+    thread_mutex_unlock(data.queue.mutex);
+    return 0;
+}
+
+static void free_frames(void)
+{
+    for (int i = 0; i < MAX_QUEUED_FRAMES; i++) {
+        free(data.queue.frames[i].video);
+        free(data.queue.frames[i].audio);
+        memset(&data.queue.frames[i], 0, sizeof(video_frame));
+    }
+}
+
+static int allocate_frames(int width, int height)
+{
+    free_frames();
+    data.queue.frame_size = width * height;
+    for (int i = 0; i < MAX_QUEUED_FRAMES; i++) {
+        data.queue.frames[i].video = (uint8_t *) malloc(data.queue.frame_size);
+        if (!data.queue.frames[i].video) {
+            free_frames();
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void stop_decoder(void)
+{
+    if (data.queue.decoder) {
+        thread_mutex_lock(data.queue.mutex);
+        data.queue.quit = 1;
+        thread_condition_signal(data.queue.frame_released);
+        thread_mutex_unlock(data.queue.mutex);
+        thread_wait(data.queue.decoder);
+        data.queue.decoder = 0;
+    }
+    if (data.queue.frame_released) {
+        thread_condition_destroy(data.queue.frame_released);
+        data.queue.frame_released = 0;
+    }
+    if (data.queue.frame_decoded) {
+        thread_condition_destroy(data.queue.frame_decoded);
+        data.queue.frame_decoded = 0;
+    }
+    if (data.queue.mutex) {
+        thread_mutex_destroy(data.queue.mutex);
+        data.queue.mutex = 0;
+    }
+}
+
+static void start_decoder(void)
+{
+    data.queue.first = 0;
+    data.queue.count = 1;
+    data.queue.finished = 0;
+    data.queue.quit = 0;
+    data.queue.mutex = thread_mutex_create();
+    data.queue.frame_decoded = thread_condition_create();
+    data.queue.frame_released = thread_condition_create();
+    if (data.queue.mutex && data.queue.frame_decoded && data.queue.frame_released) {
+        data.queue.decoder = thread_create(decode_frames, "video", 0);
+    }
+    if (!data.queue.decoder) {
+        // Frames are decoded on the calling thread, using only the first frame
+        stop_decoder();
+    }
+}
+
+static const video_frame *current_frame(void)
+{
+    return &data.queue.frames[data.queue.first];
+}
+
+static int next_frame(void)
+{
+    if (!data.queue.decoder) {
+        return smacker_next_frame(data.s) == SMACKER_FRAME_OK && store_frame(&data.queue.frames[0]);
+    }
+    thread_mutex_lock(data.queue.mutex);
+    data.queue.first = (data.queue.first + 1) % MAX_QUEUED_FRAMES;
+    data.queue.count--;
+    thread_condition_signal(data.queue.frame_released);
+    while (!data.queue.count && !data.queue.finished) {
+        thread_condition_wait(data.queue.frame_decoded, data.queue.mutex);
+    }
+    int has_frame = data.queue.count > 0;
+    thread_mutex_unlock(data.queue.mutex);
+    return has_frame;
+}
+
 static void close_smk(void)
 {
+    stop_decoder();
     if (data.s) {
         smacker_close(data.s);
         data.s = 0;
     }
+    free_frames();
 }
 
 static int load_smk(const char *filename)
@@ -77,10 +249,13 @@ static int load_smk(const char *filename)
         }
     }
 
-    if (smacker_first_frame(data.s) != SMACKER_FRAME_OK) {
+    if (!allocate_frames(width, height) ||
+        smacker_first_frame(data.s) != SMACKER_FRAME_OK ||
+        !store_frame(&data.queue.frames[0])) {
         close_smk();
         return 0;
     }
+    start_decoder();
     return 1;
 }
 
@@ -119,11 +294,11 @@ void video_init(int restart_music)
     data.restart_music = restart_music;
 
     if (data.audio.has_audio) {
-        int audio_len = smacker_get_frame_audio_size(data.s, 0);
-        if (audio_len > 0) {
+        const video_frame *frame = current_frame();
+        if (frame->audio_len > 0) {
             sound_device_use_custom_music_player(
                 data.audio.bitdepth, data.audio.channels, data.audio.rate,
-                smacker_get_frame_audio(data.s, 0), audio_len
+                frame->audio, frame->audio_len
             );
         }
     }
@@ -163,7 +338,7 @@ static int get_next_frame(void)
     int frame_no = (now_millis - data.video.start_render_millis) * 1000 / data.video.micros_per_frame;
     int draw_frame = data.video.current_frame == 0;
     while (frame_no > data.video.current_frame) {
-        if (smacker_next_frame(data.s) != SMACKER_FRAME_OK) {
+        if (!next_frame()) {
             close_smk();
             data.is_ended = 1;
             data.is_playing = 0;
@@ -173,11 +348,9 @@ static int get_next_frame(void)
         data.video.current_frame++;
         draw_frame = 1;
 
-        if (data.audio.has_audio) {
-            int audio_len = smacker_get_frame_audio_size(data.s, 0);
-            if (audio_len > 0) {
-                sound_device_write_custom_music_data(smacker_get_frame_audio(data.s, 0), audio_len);
-            }
+        const video_frame *frame = current_frame();
+        if (frame->audio_len > 0) {
+            sound_device_write_custom_music_data(frame->audio, frame->audio_len);
         }
     }
     return draw_frame;
@@ -192,8 +365,9 @@ void video_draw(int x_offset, int y_offset)
     if (!clip->is_visible) {
         return;
     }
-    const unsigned char *frame = smacker_get_frame_video(data.s);
-    const uint32_t *pal = smacker_get_frame_palette(data.s);
+    graphics_mark_dirty(x_offset, y_offset, data.video.width, data.video.height);
+    const unsigned char *frame = current_frame()->video;
+    const uint32_t *pal = current_frame()->palette;
     if (frame && pal) {
         for (int y = clip->clipped_pixels_top; y < clip->visible_pixels_y; y++) {
             color_t *pixel = graphics_get_pixel(
@@ -215,8 +389,8 @@ void video_draw_fullscreen(void)
     }
     int s_width = screen_width();
     int s_height = screen_height();
-    const unsigned char *frame = smacker_get_frame_video(data.s);
-    const uint32_t *pal = smacker_get_frame_palette(data.s);
+    const unsigned char *frame = current_frame()->video;
+    const uint32_t *pal = current_frame()->palette;
     if (frame && pal) {
         double scale_w = s_width / (double) data.video.width;
         double scale_h = s_height / (double) data.video.height * (data.video.y_scale == SMACKER_Y_SCALE_NONE ? 1 : 2);
@@ -229,6 +403,7 @@ void video_draw_fullscreen(void)
         if (!clip->is_visible) {
             return;
         }
+        graphics_mark_dirty(x_offset, y_offset, video_width, video_height);
         for (int y = clip->clipped_pixels_top; y < video_height - clip->clipped_pixels_bottom; y++) {
             color_t *pixel = graphics_get_pixel(x_offset + clip->clipped_pixels_left, y_offset + y);
             int x_max = video_width - clip->clipped_pixels_right;
@@ -10,6 +10,18 @@
  */
 static grid_u8 aqueduct;
 static grid_u8 aqueduct_backup;
+static grid_journal aqueduct_journal;
+
+static void set_aqueduct(int grid_offset, int value)
+{
+    if (aqueduct.items[grid_offset] == value) {
+        return;
+    }
+    if (map_grid_journal_add(&aqueduct_journal, grid_offset)) {
+        aqueduct_backup.items[grid_offset] = aqueduct.items[grid_offset];
+    }
+    aqueduct.items[grid_offset] = value;
+}
 
 int map_aqueduct_at(int grid_offset)
 {
@@ -18,44 +30,60 @@ int map_aqueduct_at(int grid_offset)
 
 void map_aqueduct_set(int grid_offset, int value)
 {
-    aqueduct.items[grid_offset] = value;
+    set_aqueduct(grid_offset, value);
 }
 
 void map_aqueduct_remove(int grid_offset)
 {
-    aqueduct.items[grid_offset] = 0;
+    set_aqueduct(grid_offset, 0);
     if (aqueduct.items[grid_offset + map_grid_delta(0, -1)] == 5) {
-        aqueduct.items[grid_offset + map_grid_delta(0, -1)] = 1;
+        set_aqueduct(grid_offset + map_grid_delta(0, -1), 1);
     }
     if (aqueduct.items[grid_offset + map_grid_delta(1, 0)] == 6) {
-        aqueduct.items[grid_offset + map_grid_delta(1, 0)] = 2;
+        set_aqueduct(grid_offset + map_grid_delta(1, 0), 2);
     }
     if (aqueduct.items[grid_offset + map_grid_delta(0, 1)] == 5) {
-        aqueduct.items[grid_offset + map_grid_delta(0, 1)] = 3;
+        set_aqueduct(grid_offset + map_grid_delta(0, 1), 3);
     }
     if (aqueduct.items[grid_offset + map_grid_delta(-1, 0)] == 6) {
-        aqueduct.items[grid_offset + map_grid_delta(-1, 0)] = 4;
+        set_aqueduct(grid_offset + map_grid_delta(-1, 0), 4);
     }
 }
 
 void map_aqueduct_clear(void)
 {
-    map_grid_clear_u8(aqueduct.items);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        set_aqueduct(i, 0);
+    }
 }
 
 void map_aqueduct_backup(void)
 {
-    map_grid_copy_u8(aqueduct.items, aqueduct_backup.items);
+    map_grid_journal_clear(&aqueduct_journal);
 }
 
 void map_aqueduct_restore(void)
 {
-    map_grid_copy_u8(aqueduct_backup.items, aqueduct.items);
+    for (int i = 0; i < aqueduct_journal.num_tiles; i++) {
+        int grid_offset = aqueduct_journal.tiles[i];
+        aqueduct.items[grid_offset] = aqueduct_backup.items[grid_offset];
+    }
+}
+
+void map_aqueduct_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    map_grid_journal_extend_area(&aqueduct_journal, x_min, y_min, x_max, y_max);
 }
 
 void map_aqueduct_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(aqueduct.items, buf);
+    // Tiles that did not change since the backup still have their backup value
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (!map_grid_journal_contains(&aqueduct_journal, i)) {
+            aqueduct_backup.items[i] = aqueduct.items[i];
+        }
+    }
     map_grid_save_state_u8(aqueduct_backup.items, backup);
 }
 
@@ -63,4 +91,6 @@ void map_aqueduct_load_state(buffer *buf, buffer *backup)
 {
     map_grid_load_state_u8(aqueduct.items, buf);
     map_grid_load_state_u8(aqueduct_backup.items, backup);
+    map_grid_journal_clear(&aqueduct_journal);
+    map_grid_journal_add_all(&aqueduct_journal);
 }
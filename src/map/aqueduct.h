@@ -19,6 +19,8 @@ void map_aqueduct_backup(void);
 
 void map_aqueduct_restore(void);
 
+void map_aqueduct_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max);
+
 void map_aqueduct_save_state(buffer *buf, buffer *backup);
 
 void map_aqueduct_load_state(buffer *buf, buffer *backup);
@@ -2,6 +2,9 @@
 
 #include "building/building.h"
 #include "map/grid.h"
+#include "map/road_access.h"
+#include "map/routing_terrain.h"
+#include "map/tile_changes.h"
 
 static grid_u16 buildings_grid;
 static grid_u8 damage_grid;
@@ -14,6 +17,11 @@ int map_building_at(int grid_offset)
 
 void map_building_set(int grid_offset, int building_id)
 {
+    if (buildings_grid.items[grid_offset] != building_id) {
+        map_road_access_invalidate_roaming();
+        map_routing_mark_tile_changed(grid_offset);
+        map_tile_changes_mark(grid_offset);
+    }
     buildings_grid.items[grid_offset] = building_id;
 }
 
@@ -40,6 +48,8 @@ void map_set_rubble_building_type(int grid_offset, building_type type)
 void map_building_clear(void)
 {
     map_grid_clear_u16(buildings_grid.items);
+    map_road_access_invalidate_roaming();
+    map_routing_mark_all_changed();
     map_grid_clear_u8(damage_grid.items);
     map_grid_clear_u8(rubble_type_grid.items);
 }
@@ -53,6 +63,8 @@ void map_building_save_state(buffer *buildings, buffer *damage)
 void map_building_load_state(buffer *buildings, buffer *damage)
 {
     map_grid_load_state_u16(buildings_grid.items, buildings);
+    map_road_access_invalidate_roaming();
+    map_routing_mark_all_changed();
     map_grid_load_state_u8(damage_grid.items, damage);
 }
 
@@ -226,6 +226,83 @@ void map_grid_copy_u16(const uint16_t *src, uint16_t *dst)
     memcpy(dst, src, GRID_SIZE * GRID_SIZE * sizeof(uint16_t));
 }
 
+static int journal_changes;
+
+void map_grid_journal_clear(grid_journal *journal)
+{
+    journal->num_tiles = 0;
+    journal->x_min = GRID_SIZE;
+    journal->y_min = GRID_SIZE;
+    journal->x_max = -1;
+    journal->y_max = -1;
+    journal->generation++;
+    if (!journal->generation) {
+        map_grid_clear_u16(journal->stamps.items);
+        journal->generation = 1;
+    }
+}
+
+int map_grid_journal_add(grid_journal *journal, int grid_offset)
+{
+    journal_changes++;
+    if (journal->stamps.items[grid_offset] == journal->generation) {
+        return 0;
+    }
+    journal->stamps.items[grid_offset] = journal->generation;
+    journal->tiles[journal->num_tiles++] = grid_offset;
+    int x = map_grid_offset_to_x(grid_offset);
+    int y = map_grid_offset_to_y(grid_offset);
+    if (x < journal->x_min) {
+        journal->x_min = x;
+    }
+    if (x > journal->x_max) {
+        journal->x_max = x;
+    }
+    if (y < journal->y_min) {
+        journal->y_min = y;
+    }
+    if (y > journal->y_max) {
+        journal->y_max = y;
+    }
+    return 1;
+}
+
+void map_grid_journal_add_all(grid_journal *journal)
+{
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        map_grid_journal_add(journal, i);
+    }
+}
+
+int map_grid_journal_contains(const grid_journal *journal, int grid_offset)
+{
+    return journal->stamps.items[grid_offset] == journal->generation;
+}
+
+void map_grid_journal_extend_area(const grid_journal *journal, int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    if (!journal->num_tiles) {
+        return;
+    }
+    if (journal->x_min < *x_min) {
+        *x_min = journal->x_min;
+    }
+    if (journal->y_min < *y_min) {
+        *y_min = journal->y_min;
+    }
+    if (journal->x_max > *x_max) {
+        *x_max = journal->x_max;
+    }
+    if (journal->y_max > *y_max) {
+        *y_max = journal->y_max;
+    }
+}
+
+int map_grid_journal_changes(void)
+{
+    return journal_changes;
+}
+
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf)
 {
     buffer_write_raw(buf, grid, GRID_SIZE * GRID_SIZE);
@@ -238,9 +315,7 @@ void map_grid_save_state_i8(const int8_t *grid, buffer *buf)
 
 void map_grid_save_state_u16(const uint16_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        buffer_write_u16(buf, grid[i]);
-    }
+    buffer_write_u16_array(buf, grid, GRID_SIZE * GRID_SIZE);
 }
 
 void map_grid_load_state_u8(uint8_t *grid, buffer *buf)
@@ -255,7 +330,5 @@ void map_grid_load_state_i8(int8_t *grid, buffer *buf)
 
 void map_grid_load_state_u16(uint16_t *grid, buffer *buf)
 {
-    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
-        grid[i] = buffer_read_u16(buf);
-    }
+    buffer_read_u16_array(buf, grid, GRID_SIZE * GRID_SIZE);
 }
@@ -25,6 +25,21 @@ typedef struct {
     int16_t items[GRID_SIZE * GRID_SIZE];
 } grid_i16;
 
+/**
+ * Journal of the tiles of a grid that changed since its last backup.
+ * Only the original values of those tiles need to be kept and restored.
+ */
+typedef struct {
+    uint16_t generation;
+    int num_tiles;
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+    grid_u16 stamps;
+    int tiles[GRID_SIZE * GRID_SIZE];
+} grid_journal;
+
 void map_grid_init(int width, int height, int start_offset, int border_size);
 
 int map_grid_is_valid_offset(int grid_offset);
@@ -84,6 +99,51 @@ void map_grid_copy_u8(const uint8_t *src, uint8_t *dst);
 
 void map_grid_copy_u16(const uint16_t *src, uint16_t *dst);
 
+/**
+ * Empties the journal: all tiles are considered unchanged from now on
+ * @param journal Journal
+ */
+void map_grid_journal_clear(grid_journal *journal);
+
+/**
+ * Adds a tile to the journal
+ * @param journal Journal
+ * @param grid_offset Tile
+ * @return 1 if the tile was added, 0 if it was already in the journal
+ */
+int map_grid_journal_add(grid_journal *journal, int grid_offset);
+
+/**
+ * Adds all tiles to the journal
+ * @param journal Journal
+ */
+void map_grid_journal_add_all(grid_journal *journal);
+
+/**
+ * Checks whether a tile is in the journal
+ * @param journal Journal
+ * @param grid_offset Tile
+ * @return 1 if the tile changed since the journal was cleared
+ */
+int map_grid_journal_contains(const grid_journal *journal, int grid_offset);
+
+/**
+ * Extends an area so that it includes all tiles in the journal
+ * @param journal Journal
+ * @param x_min Minimum X of the area, updated in place
+ * @param y_min Minimum Y of the area, updated in place
+ * @param x_max Maximum X of the area, updated in place
+ * @param y_max Maximum Y of the area, updated in place
+ */
+void map_grid_journal_extend_area(const grid_journal *journal, int *x_min, int *y_min, int *x_max, int *y_max);
+
+/**
+ * Gets the number of tile changes recorded in any journal so far.
+ * When this number is the same as before, no journalled grid has changed in between.
+ * @return Change counter
+ */
+int map_grid_journal_changes(void);
+
 
 void map_grid_save_state_u8(const uint8_t *grid, buffer *buf);
 
@@ -1,9 +1,37 @@
 #include "image.h"
 
+#include "map/building.h"
 #include "map/grid.h"
+#include "map/routing_terrain.h"
+#include "map/terrain.h"
 
 static grid_u16 images;
 static grid_u16 images_backup;
+static grid_journal images_journal;
+
+static void backup_tile(int grid_offset)
+{
+    if (map_grid_journal_add(&images_journal, grid_offset)) {
+        images_backup.items[grid_offset] = images.items[grid_offset];
+    }
+}
+
+static void image_changed(int grid_offset)
+{
+    // the aqueduct image decides whether citizens can walk under it
+    if (map_terrain_is(grid_offset, TERRAIN_AQUEDUCT)) {
+        map_routing_mark_tile_changed(grid_offset);
+    }
+}
+
+static void set_image(int grid_offset, int image_id)
+{
+    if (images.items[grid_offset] != image_id) {
+        backup_tile(grid_offset);
+        images.items[grid_offset] = image_id;
+        image_changed(grid_offset);
+    }
+}
 
 int map_image_at(int grid_offset)
 {
@@ -12,27 +40,62 @@ int map_image_at(int grid_offset)
 
 void map_image_set(int grid_offset, int image_id)
 {
+    set_image(grid_offset, image_id);
+}
+
+void map_image_set_animation_frame(int grid_offset, int image_id)
+{
+    // animation frames are not map changes: keep them out of the journal
     images.items[grid_offset] = image_id;
 }
 
 void map_image_backup(void)
 {
-    map_grid_copy_u16(images.items, images_backup.items);
+    map_grid_journal_clear(&images_journal);
 }
 
 void map_image_restore(void)
 {
-    map_grid_copy_u16(images_backup.items, images.items);
+    for (int i = 0; i < images_journal.num_tiles; i++) {
+        int grid_offset = images_journal.tiles[i];
+        images.items[grid_offset] = images_backup.items[grid_offset];
+        image_changed(grid_offset);
+    }
+}
+
+void map_image_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    map_grid_journal_extend_area(&images_journal, x_min, y_min, x_max, y_max);
 }
 
 void map_image_restore_at(int grid_offset)
 {
-    images.items[grid_offset] = images_backup.items[grid_offset];
+    if (map_grid_journal_contains(&images_journal, grid_offset)) {
+        images.items[grid_offset] = images_backup.items[grid_offset];
+        image_changed(grid_offset);
+    }
+}
+
+void map_image_restore_without_building(void)
+{
+    int map_width, map_height;
+    map_grid_size(&map_width, &map_height);
+    for (int i = 0; i < images_journal.num_tiles; i++) {
+        int grid_offset = images_journal.tiles[i];
+        int x = map_grid_offset_to_x(grid_offset);
+        int y = map_grid_offset_to_y(grid_offset);
+        if (x >= 0 && x < map_width && y >= 0 && y < map_height && !map_building_at(grid_offset)) {
+            images.items[grid_offset] = images_backup.items[grid_offset];
+            image_changed(grid_offset);
+        }
+    }
 }
 
 void map_image_clear(void)
 {
-    map_grid_clear_u16(images.items);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        set_image(i, 0);
+    }
 }
 
 void map_image_init_edges(void)
@@ -40,14 +103,14 @@ void map_image_init_edges(void)
     int width, height;
     map_grid_size(&width, &height);
     for (int x = 1; x < width; x++) {
-        images.items[map_grid_offset(x, height)] = 1;
+        set_image(map_grid_offset(x, height), 1);
     }
     for (int y = 1; y < height; y++) {
-        images.items[map_grid_offset(width, y)] = 2;
+        set_image(map_grid_offset(width, y), 2);
     }
-    images.items[map_grid_offset(0, height)] = 3;
-    images.items[map_grid_offset(width, 0)] = 4;
-    images.items[map_grid_offset(width, height)] = 5;
+    set_image(map_grid_offset(0, height), 3);
+    set_image(map_grid_offset(width, 0), 4);
+    set_image(map_grid_offset(width, height), 5);
 }
 
 void map_image_save_state(buffer *buf)
@@ -57,5 +120,9 @@ void map_image_save_state(buffer *buf)
 
 void map_image_load_state(buffer *buf)
 {
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        backup_tile(i);
+    }
     map_grid_load_state_u16(images.items, buf);
+    map_routing_mark_all_changed();
 }
@@ -7,12 +7,27 @@ int map_image_at(int grid_offset);
 
 void map_image_set(int grid_offset, int image_id);
 
+/**
+ * Sets the image of a tile to another frame of its animation, while drawing.
+ * Unlike map_image_set, this is not journalled for undo and does not count as a map change.
+ * @param grid_offset Tile
+ * @param image_id Image of the new frame
+ */
+void map_image_set_animation_frame(int grid_offset, int image_id);
+
 void map_image_backup(void);
 
 void map_image_restore(void);
 
 void map_image_restore_at(int grid_offset);
 
+void map_image_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max);
+
+/**
+ * Restores the backed up images of all tiles on the map without a building
+ */
+void map_image_restore_without_building(void);
+
 void map_image_clear(void);
 void map_image_init_edges(void);
 
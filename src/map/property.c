@@ -2,6 +2,8 @@
 
 #include "map/grid.h"
 #include "map/random.h"
+#include "map/routing_terrain.h"
+#include "map/tile_changes.h"
 
 enum {
     BIT_SIZE1 = 0x00,
@@ -33,6 +35,47 @@ static grid_u8 bitfields_grid;
 
 static grid_u8 edge_backup;
 static grid_u8 bitfields_backup;
+static grid_journal journal;
+
+// tiles that may have the constructing or deleted flag set
+static grid_journal marked;
+
+static void backup_tile(int grid_offset)
+{
+    if (map_grid_journal_add(&journal, grid_offset)) {
+        edge_backup.items[grid_offset] = edge_grid.items[grid_offset];
+        bitfields_backup.items[grid_offset] = bitfields_grid.items[grid_offset];
+    }
+}
+
+static void set_edge(int grid_offset, uint8_t value)
+{
+    if (edge_grid.items[grid_offset] != value) {
+        backup_tile(grid_offset);
+        if ((edge_grid.items[grid_offset] ^ value) & EDGE_MASK_XY) {
+            // the position within a building decides which of its tiles can be crossed
+            map_routing_mark_tile_changed(grid_offset);
+        }
+        if ((edge_grid.items[grid_offset] ^ value) & EDGE_LEFTMOST_TILE) {
+            map_tile_changes_mark(grid_offset);
+        }
+        edge_grid.items[grid_offset] = value;
+    }
+}
+
+static void set_bitfields(int grid_offset, uint8_t value)
+{
+    if (bitfields_grid.items[grid_offset] != value) {
+        backup_tile(grid_offset);
+        if ((bitfields_grid.items[grid_offset] ^ value) & BIT_SIZES) {
+            map_tile_changes_mark(grid_offset);
+        }
+        bitfields_grid.items[grid_offset] = value;
+        if (value & (BIT_CONSTRUCTION | BIT_DELETED)) {
+            map_grid_journal_add(&marked, grid_offset);
+        }
+    }
+}
 
 static int edge_for(int x, int y)
 {
@@ -46,12 +89,12 @@ int map_property_is_draw_tile(int grid_offset)
 
 void map_property_mark_draw_tile(int grid_offset)
 {
-    edge_grid.items[grid_offset] |= EDGE_LEFTMOST_TILE;
+    set_edge(grid_offset, edge_grid.items[grid_offset] | EDGE_LEFTMOST_TILE);
 }
 
 void map_property_clear_draw_tile(int grid_offset)
 {
-    edge_grid.items[grid_offset] &= ~EDGE_LEFTMOST_TILE;
+    set_edge(grid_offset, edge_grid.items[grid_offset] & ~EDGE_LEFTMOST_TILE);
 }
 
 int map_property_is_native_land(int grid_offset)
@@ -61,12 +104,14 @@ int map_property_is_native_land(int grid_offset)
 
 void map_property_mark_native_land(int grid_offset)
 {
-    edge_grid.items[grid_offset] |= EDGE_NATIVE_LAND;
+    set_edge(grid_offset, edge_grid.items[grid_offset] | EDGE_NATIVE_LAND);
 }
 
 void map_property_clear_all_native_land(void)
 {
-    map_grid_and_u8(edge_grid.items, EDGE_NO_NATIVE_LAND);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        set_edge(i, edge_grid.items[i] & EDGE_NO_NATIVE_LAND);
+    }
 }
 
 int map_property_multi_tile_xy(int grid_offset)
@@ -92,16 +137,16 @@ int map_property_is_multi_tile_xy(int grid_offset, int x, int y)
 void map_property_set_multi_tile_xy(int grid_offset, int x, int y, int is_draw_tile)
 {
     if (is_draw_tile) {
-        edge_grid.items[grid_offset] = edge_for(x, y) | EDGE_LEFTMOST_TILE;
+        set_edge(grid_offset, edge_for(x, y) | EDGE_LEFTMOST_TILE);
     } else {
-        edge_grid.items[grid_offset] = edge_for(x, y);
+        set_edge(grid_offset, edge_for(x, y));
     }
 }
 
 void map_property_clear_multi_tile_xy(int grid_offset)
 {
     // only keep native land marker
-    edge_grid.items[grid_offset] &= EDGE_NATIVE_LAND;
+    set_edge(grid_offset, edge_grid.items[grid_offset] & EDGE_NATIVE_LAND);
 }
 
 int map_property_multi_tile_size(int grid_offset)
@@ -117,13 +162,14 @@ int map_property_multi_tile_size(int grid_offset)
 
 void map_property_set_multi_tile_size(int grid_offset, int size)
 {
-    bitfields_grid.items[grid_offset] &= BIT_NO_SIZES;
+    uint8_t bits = bitfields_grid.items[grid_offset] & BIT_NO_SIZES;
     switch (size) {
-        case 2: bitfields_grid.items[grid_offset] |= BIT_SIZE2; break;
-        case 3: bitfields_grid.items[grid_offset] |= BIT_SIZE3; break;
-        case 4: bitfields_grid.items[grid_offset] |= BIT_SIZE4; break;
-        case 5: bitfields_grid.items[grid_offset] |= BIT_SIZE5; break;
+        case 2: bits |= BIT_SIZE2; break;
+        case 3: bits |= BIT_SIZE3; break;
+        case 4: bits |= BIT_SIZE4; break;
+        case 5: bits |= BIT_SIZE5; break;
     }
+    set_bitfields(grid_offset, bits);
 }
 
 void map_property_init_alternate_terrain(void)
@@ -134,7 +180,7 @@ void map_property_init_alternate_terrain(void)
         for (int x = 0; x < map_width; x++) {
             int grid_offset = map_grid_offset(x, y);
             if (map_random_get(grid_offset) & 1) {
-                bitfields_grid.items[grid_offset] |= BIT_ALTERNATE_TERRAIN;
+                set_bitfields(grid_offset, bitfields_grid.items[grid_offset] | BIT_ALTERNATE_TERRAIN);
             }
         }
     }
@@ -152,12 +198,12 @@ int map_property_is_plaza_or_earthquake(int grid_offset)
 
 void map_property_mark_plaza_or_earthquake(int grid_offset)
 {
-    bitfields_grid.items[grid_offset] |= BIT_PLAZA_OR_EARTHQUAKE;
+    set_bitfields(grid_offset, bitfields_grid.items[grid_offset] | BIT_PLAZA_OR_EARTHQUAKE);
 }
 
 void map_property_clear_plaza_or_earthquake(int grid_offset)
 {
-    bitfields_grid.items[grid_offset] &= BIT_NO_PLAZA;
+    set_bitfields(grid_offset, bitfields_grid.items[grid_offset] & BIT_NO_PLAZA);
 }
 
 int map_property_is_constructing(int grid_offset)
@@ -167,12 +213,12 @@ int map_property_is_constructing(int grid_offset)
 
 void map_property_mark_constructing(int grid_offset)
 {
-    bitfields_grid.items[grid_offset] |= BIT_CONSTRUCTION;
+    set_bitfields(grid_offset, bitfields_grid.items[grid_offset] | BIT_CONSTRUCTION);
 }
 
 void map_property_clear_constructing(int grid_offset)
 {
-    bitfields_grid.items[grid_offset] &= BIT_NO_CONSTRUCTION;
+    set_bitfields(grid_offset, bitfields_grid.items[grid_offset] & BIT_NO_CONSTRUCTION);
 }
 
 int map_property_is_deleted(int grid_offset)
@@ -182,35 +228,59 @@ int map_property_is_deleted(int grid_offset)
 
 void map_property_mark_deleted(int grid_offset)
 {
-    bitfields_grid.items[grid_offset] |= BIT_DELETED;
+    set_bitfields(grid_offset, bitfields_grid.items[grid_offset] | BIT_DELETED);
 }
 
 void map_property_clear_deleted(int grid_offset)
 {
-    bitfields_grid.items[grid_offset] &= BIT_NO_DELETED;
+    set_bitfields(grid_offset, bitfields_grid.items[grid_offset] & BIT_NO_DELETED);
 }
 
 void map_property_clear_constructing_and_deleted(void)
 {
-    map_grid_and_u8(bitfields_grid.items, BIT_NO_CONSTRUCTION_AND_DELETED);
+    for (int i = 0; i < marked.num_tiles; i++) {
+        int grid_offset = marked.tiles[i];
+        set_bitfields(grid_offset, bitfields_grid.items[grid_offset] & BIT_NO_CONSTRUCTION_AND_DELETED);
+    }
+    map_grid_journal_clear(&marked);
 }
 
 void map_property_clear(void)
 {
-    map_grid_clear_u8(bitfields_grid.items);
-    map_grid_clear_u8(edge_grid.items);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        set_bitfields(i, 0);
+        set_edge(i, 0);
+    }
+    map_grid_journal_clear(&marked);
 }
 
 void map_property_backup(void)
 {
-    map_grid_copy_u8(bitfields_grid.items, bitfields_backup.items);
-    map_grid_copy_u8(edge_grid.items, edge_backup.items);
+    map_grid_journal_clear(&journal);
 }
 
 void map_property_restore(void)
 {
-    map_grid_copy_u8(bitfields_backup.items, bitfields_grid.items);
-    map_grid_copy_u8(edge_backup.items, edge_grid.items);
+    for (int i = 0; i < journal.num_tiles; i++) {
+        int grid_offset = journal.tiles[i];
+        if (((bitfields_grid.items[grid_offset] ^ bitfields_backup.items[grid_offset]) & BIT_SIZES) ||
+            ((edge_grid.items[grid_offset] ^ edge_backup.items[grid_offset]) & EDGE_LEFTMOST_TILE)) {
+            map_tile_changes_mark(grid_offset);
+        }
+        bitfields_grid.items[grid_offset] = bitfields_backup.items[grid_offset];
+        if ((edge_grid.items[grid_offset] ^ edge_backup.items[grid_offset]) & EDGE_MASK_XY) {
+            map_routing_mark_tile_changed(grid_offset);
+        }
+        edge_grid.items[grid_offset] = edge_backup.items[grid_offset];
+        if (bitfields_grid.items[grid_offset] & (BIT_CONSTRUCTION | BIT_DELETED)) {
+            map_grid_journal_add(&marked, grid_offset);
+        }
+    }
+}
+
+void map_property_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    map_grid_journal_extend_area(&journal, x_min, y_min, x_max, y_max);
 }
 
 void map_property_save_state(buffer *bitfields, buffer *edge)
@@ -221,6 +291,12 @@ void map_property_save_state(buffer *bitfields, buffer *edge)
 
 void map_property_load_state(buffer *bitfields, buffer *edge)
 {
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        backup_tile(i);
+    }
     map_grid_load_state_u8(bitfields_grid.items, bitfields);
     map_grid_load_state_u8(edge_grid.items, edge);
+    map_routing_mark_all_changed();
+    map_grid_journal_clear(&marked);
+    map_grid_journal_add_all(&marked);
 }
@@ -54,6 +54,7 @@ void map_property_clear(void);
 
 void map_property_backup(void);
 void map_property_restore(void);
+void map_property_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max);
 
 void map_property_save_state(buffer *bitfields, buffer *edge);
 void map_property_load_state(buffer *bitfields, buffer *edge);
@@ -9,6 +9,16 @@
 #include "map/routing_terrain.h"
 #include "map/terrain.h"
 
+// Cached road neighbours for roaming walkers: bit n is set when the tile in direction n is road.
+// A tile's mask is valid when its stamp equals the current generation.
+static struct {
+    uint16_t generation;
+    grid_u8 mask;
+    grid_u16 stamp;
+    uint8_t max_stretch[256];
+    int max_stretch_initialized;
+} roaming = {1};
+
 static void find_minimum_road_tile(int x, int y, int size, int *min_value, int *min_grid_offset)
 {
     int base_offset = map_grid_offset(x, y);
@@ -260,36 +270,97 @@ static int get_adjacent_road_tile_for_roaming(int grid_offset)
     return is_road;
 }
 
+static int calculate_roaming_mask(int grid_offset)
+{
+    int mask = 0;
+    if (get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(0, -1))) {
+        mask |= 1 << 0;
+    }
+    if (terrain_is_road_like(grid_offset + map_grid_delta(1, -1))) {
+        mask |= 1 << 1;
+    }
+    if (get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(1, 0))) {
+        mask |= 1 << 2;
+    }
+    if (terrain_is_road_like(grid_offset + map_grid_delta(1, 1))) {
+        mask |= 1 << 3;
+    }
+    if (get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(0, 1))) {
+        mask |= 1 << 4;
+    }
+    if (terrain_is_road_like(grid_offset + map_grid_delta(-1, 1))) {
+        mask |= 1 << 5;
+    }
+    if (get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(-1, 0))) {
+        mask |= 1 << 6;
+    }
+    if (terrain_is_road_like(grid_offset + map_grid_delta(-1, -1))) {
+        mask |= 1 << 7;
+    }
+    return mask;
+}
+
+static void init_max_stretch(void)
+{
+    for (int mask = 0; mask < 256; mask++) {
+        int max_stretch = 0;
+        int stretch = 0;
+        for (int i = 0; i < 16; i++) {
+            if (mask & (1 << (i % 8))) {
+                stretch++;
+                if (stretch > max_stretch) {
+                    max_stretch = stretch;
+                }
+            } else {
+                stretch = 0;
+            }
+        }
+        roaming.max_stretch[mask] = max_stretch;
+    }
+    roaming.max_stretch_initialized = 1;
+}
+
+void map_road_access_invalidate_roaming(void)
+{
+    roaming.generation++;
+    if (!roaming.generation) {
+        map_grid_clear_u16(roaming.stamp.items);
+        roaming.generation = 1;
+    }
+}
+
+int map_road_access_roaming_mask(int grid_offset)
+{
+    if (roaming.stamp.items[grid_offset] != roaming.generation) {
+        roaming.mask.items[grid_offset] = calculate_roaming_mask(grid_offset);
+        roaming.stamp.items[grid_offset] = roaming.generation;
+    }
+    return roaming.mask.items[grid_offset];
+}
+
 int map_get_adjacent_road_tiles_for_roaming(int grid_offset, int *road_tiles)
 {
+    int mask = map_road_access_roaming_mask(grid_offset);
     road_tiles[1] = road_tiles[3] = road_tiles[5] = road_tiles[7] = 0;
 
-    road_tiles[0] = get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(0, -1));
-    road_tiles[2] = get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(1, 0));
-    road_tiles[4] = get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(0, 1));
-    road_tiles[6] = get_adjacent_road_tile_for_roaming(grid_offset + map_grid_delta(-1, 0));
+    road_tiles[0] = (mask >> 0) & 1;
+    road_tiles[2] = (mask >> 2) & 1;
+    road_tiles[4] = (mask >> 4) & 1;
+    road_tiles[6] = (mask >> 6) & 1;
 
     return road_tiles[0] + road_tiles[2] + road_tiles[4] + road_tiles[6];
 }
 
 int map_get_diagonal_road_tiles_for_roaming(int grid_offset, int *road_tiles)
 {
-    road_tiles[1] = terrain_is_road_like(grid_offset + map_grid_delta(1, -1));
-    road_tiles[3] = terrain_is_road_like(grid_offset + map_grid_delta(1, 1));
-    road_tiles[5] = terrain_is_road_like(grid_offset + map_grid_delta(-1, 1));
-    road_tiles[7] = terrain_is_road_like(grid_offset + map_grid_delta(-1, -1));
+    int mask = map_road_access_roaming_mask(grid_offset);
+    road_tiles[1] = (mask >> 1) & 1;
+    road_tiles[3] = (mask >> 3) & 1;
+    road_tiles[5] = (mask >> 5) & 1;
+    road_tiles[7] = (mask >> 7) & 1;
 
-    int max_stretch = 0;
-    int stretch = 0;
-    for (int i = 0; i < 16; i++) {
-        if (road_tiles[i % 8]) {
-            stretch++;
-            if (stretch > max_stretch) {
-                max_stretch = stretch;
-            }
-        } else {
-            stretch = 0;
-        }
+    if (!roaming.max_stretch_initialized) {
+        init_max_stretch();
     }
-    return max_stretch;
+    return roaming.max_stretch[mask];
 }
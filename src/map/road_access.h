@@ -17,6 +17,19 @@ int map_road_to_largest_network(int x, int y, int size, int *x_road, int *y_road
 
 int map_road_to_largest_network_hippodrome(int x, int y, int *x_road, int *y_road);
 
+/**
+ * Gets the road neighbours of a tile, as used by roaming walkers
+ * @param grid_offset Tile to check
+ * @return Bit mask: bit n is set when the tile in direction n is road
+ */
+int map_road_access_roaming_mask(int grid_offset);
+
+/**
+ * Marks all cached roaming road neighbours as outdated.
+ * Must be called whenever terrain, buildings or citizen routing change.
+ */
+void map_road_access_invalidate_roaming(void);
+
 int map_get_adjacent_road_tiles_for_roaming(int grid_offset, int *road_tiles);
 
 int map_get_diagonal_road_tiles_for_roaming(int grid_offset, int *road_tiles);
@@ -8,6 +8,8 @@
 #include "map/routing_data.h"
 #include "map/terrain.h"
 
+#include <string.h>
+
 #define MAX_QUEUE GRID_SIZE * GRID_SIZE
 #define GUARD 50000
 
@@ -31,6 +33,23 @@ static struct {
 
 static grid_u8 water_drag;
 
+static struct {
+    int enabled;
+    int valid;
+    routed_building_type type;
+    int source_offset;
+    int result;
+    grid_i16 distance;
+} building_cache;
+
+// search of route_queue_max() that stopped at its tile limit and can be continued.
+// Only the search of the current figure is kept: each formation member still floods on its own
+static struct {
+    int active;
+    int dest;
+    int tiles;
+} capped_search;
+
 static struct {
     int through_building_id;
 } state;
@@ -38,6 +57,7 @@ static struct {
 static void clear_distances(void)
 {
     map_grid_clear_i16(routing_distance.items);
+    capped_search.active = 0;
 }
 
 static void enqueue(int next_offset, int dist)
@@ -97,16 +117,17 @@ static void route_queue_until(int source, int (*callback)(int next_offset, int d
     }
 }
 
-static void route_queue_max(int source, int dest, int max_tiles, void (*callback)(int, int))
+static void continue_route_queue_max(int max_tiles, void (*callback)(int, int))
 {
-    clear_distances();
-    queue.head = queue.tail = 0;
-    enqueue(source, 1);
-    int tiles = 0;
+    capped_search.active = 0;
     while (queue.head != queue.tail) {
         int offset = queue.items[queue.head];
-        if (offset == dest) break;
-        if (++tiles > max_tiles) break;
+        if (offset == capped_search.dest) break;
+        if (capped_search.tiles >= max_tiles) {
+            capped_search.active = 1;
+            break;
+        }
+        capped_search.tiles++;
         int dist = 1 + routing_distance.items[offset];
         for (int i = 0; i < 4; i++) {
             if (valid_offset(offset + ROUTE_OFFSETS[i])) {
@@ -119,6 +140,16 @@ static void route_queue_max(int source, int dest, int max_tiles, void (*callback
     }
 }
 
+static void route_queue_max(int source, int dest, int max_tiles, void (*callback)(int, int))
+{
+    clear_distances();
+    queue.head = queue.tail = 0;
+    enqueue(source, 1);
+    capped_search.dest = dest;
+    capped_search.tiles = 0;
+    continue_route_queue_max(max_tiles, callback);
+}
+
 static void route_queue_boat(int source, void (*callback)(int, int))
 {
     clear_distances();
@@ -317,14 +348,13 @@ static int map_can_place_initial_road_or_aqueduct(int grid_offset, int is_aquedu
     }
 }
 
-int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
+static int calculate_distances_for_building(routed_building_type type, int source_offset)
 {
     if (type == ROUTED_BUILDING_WALL) {
-        route_queue(map_grid_offset(x, y), -1, callback_calc_distance_build_wall);
+        route_queue(source_offset, -1, callback_calc_distance_build_wall);
         return 1;
     }
     clear_distances();
-    int source_offset = map_grid_offset(x, y);
     if (!map_can_place_initial_road_or_aqueduct(source_offset, type != ROUTED_BUILDING_ROAD)) {
         return 0;
     }
@@ -341,6 +371,37 @@ int map_routing_calculate_distances_for_building(routed_building_type type, int
     return 1;
 }
 
+int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y)
+{
+    int source_offset = map_grid_offset(x, y);
+    if (building_cache.valid && building_cache.type == type && building_cache.source_offset == source_offset) {
+        memcpy(routing_distance.items, building_cache.distance.items, sizeof(building_cache.distance.items));
+        capped_search.active = 0;
+        if (type != ROUTED_BUILDING_WALL && building_cache.result) {
+            // keep the saved statistics the same as without the cache
+            ++stats.total_routes_calculated;
+        }
+        return building_cache.result;
+    }
+    int result = calculate_distances_for_building(type, source_offset);
+    if (building_cache.enabled) {
+        building_cache.valid = 1;
+        building_cache.type = type;
+        building_cache.source_offset = source_offset;
+        building_cache.result = result;
+        memcpy(building_cache.distance.items, routing_distance.items, sizeof(building_cache.distance.items));
+    }
+    return result;
+}
+
+void map_routing_cache_building_distances(int enabled)
+{
+    building_cache.enabled = enabled;
+    if (!enabled) {
+        building_cache.valid = 0;
+    }
+}
+
 static int callback_delete_wall_aqueduct(int next_offset, int dist)
 {
     if (terrain_land_citizen.items[next_offset] < CITIZEN_0_ROAD) {
@@ -468,6 +529,16 @@ int map_routing_noncitizen_can_travel_over_land(
     return routing_distance.items[dst_offset] != 0;
 }
 
+int map_routing_noncitizen_continue_over_land(int max_tiles)
+{
+    ++stats.total_routes_calculated;
+    ++stats.enemy_routes_calculated;
+    if (capped_search.active) {
+        continue_route_queue_max(max_tiles, callback_travel_noncitizen_land);
+    }
+    return routing_distance.items[capped_search.dest] != 0;
+}
+
 static void callback_travel_noncitizen_through_everything(int next_offset, int dist)
 {
     if (terrain_land_noncitizen.items[next_offset] >= NONCITIZEN_0_PASSABLE) {
@@ -489,6 +560,7 @@ void map_routing_block(int x, int y, int size)
     if (!map_grid_is_inside(x, y, size)) {
         return;
     }
+    capped_search.active = 0;
     for (int dy = 0; dy < size; dy++) {
         for (int dx = 0; dx < size; dx++) {
             routing_distance.items[map_grid_offset(x+dx, y+dy)] = 0;
@@ -16,6 +16,14 @@ void map_routing_calculate_distances_water_flotsam(int x, int y);
 
 int map_routing_calculate_distances_for_building(routed_building_type type, int x, int y);
 
+/**
+ * Keeps the result of map_routing_calculate_distances_for_building() and reuses it for the same
+ * building type and start tile, for example while dragging a road.
+ * The cache must be disabled as soon as the map changes.
+ * @param enabled 1 to start or keep caching, 0 to disable and drop the cached distances
+ */
+void map_routing_cache_building_distances(int enabled);
+
 void map_routing_delete_first_wall_or_aqueduct(int x, int y);
 
 int map_routing_distance(int grid_offset);
@@ -26,6 +34,13 @@ int map_routing_can_travel_over_walls(int src_x, int src_y, int dst_x, int dst_y
 
 int map_routing_noncitizen_can_travel_over_land(
     int src_x, int src_y, int dst_x, int dst_y, int only_through_building_id, int max_tiles);
+/**
+ * Continues the last map_routing_noncitizen_can_travel_over_land() search without a building
+ * up to a larger tile limit. The result is the same as searching again with the new limit.
+ * @param max_tiles Tile limit, should be larger than the limit of the previous search
+ * @return 1 if the destination of the previous search can be reached, 0 otherwise
+ */
+int map_routing_noncitizen_continue_over_land(int max_tiles);
 int map_routing_noncitizen_can_travel_through_everything(int src_x, int src_y, int dst_x, int dst_y);
 
 void map_routing_block(int x, int y, int size);
@@ -4,19 +4,116 @@
 #include "city/view.h"
 #include "core/direction.h"
 #include "core/image.h"
+#include "core/thread_pool.h"
 #include "map/building.h"
 #include "map/data.h"
 #include "map/image.h"
 #include "map/property.h"
 #include "map/random.h"
+#include "map/road_access.h"
 #include "map/routing_data.h"
 #include "map/sprite.h"
 #include "map/terrain.h"
 
+// rows per task when a grid is rebuilt in parallel
+#define MIN_ROWS_PER_TASK 8
+
+typedef enum {
+    GRID_LAND_CITIZEN = 0,
+    GRID_LAND_NONCITIZEN = 1,
+    GRID_WATER = 2,
+    GRID_WALLS = 3,
+    NUM_GRIDS = 4
+} routing_grid;
+
+typedef struct {
+    int x_min;
+    int y_min;
+    int x_max;
+    int y_max;
+} area;
+
+// tiles changed since each grid was last rebuilt; empty when x_min > x_max
+static area changed[NUM_GRIDS] = {
+    {0, 0, GRID_SIZE, GRID_SIZE},
+    {0, 0, GRID_SIZE, GRID_SIZE},
+    {0, 0, GRID_SIZE, GRID_SIZE},
+    {0, 0, GRID_SIZE, GRID_SIZE}
+};
+
+static int walls_orientation = -1;
+
 static void map_routing_update_land_noncitizen(void);
 
+// rows with building tiles that have no building, fixed after the parallel citizen pass
+static uint8_t rows_with_invalid_buildings[GRID_SIZE];
+
+void map_routing_mark_tile_changed(int grid_offset)
+{
+    int x = map_grid_offset_to_x(grid_offset);
+    int y = map_grid_offset_to_y(grid_offset);
+    for (int i = 0; i < NUM_GRIDS; i++) {
+        area *a = &changed[i];
+        if (a->x_min > a->x_max) {
+            a->x_min = a->x_max = x;
+            a->y_min = a->y_max = y;
+            continue;
+        }
+        if (x < a->x_min) a->x_min = x;
+        if (x > a->x_max) a->x_max = x;
+        if (y < a->y_min) a->y_min = y;
+        if (y > a->y_max) a->y_max = y;
+    }
+}
+
+void map_routing_mark_all_changed(void)
+{
+    for (int i = 0; i < NUM_GRIDS; i++) {
+        changed[i].x_min = changed[i].y_min = 0;
+        changed[i].x_max = changed[i].y_max = GRID_SIZE;
+    }
+}
+
+// returns 0 if nothing changed, 1 to rebuild area a, or 2 when that area is the whole map;
+// border is the number of tiles around a changed tile that depend on it
+static int take_changed_area(routing_grid grid, int border, area *a)
+{
+    *a = changed[grid];
+    changed[grid].x_min = 1;
+    changed[grid].x_max = 0;
+    if (a->x_min > a->x_max) {
+        return 0;
+    }
+    a->x_min = a->x_min - border < 0 ? 0 : a->x_min - border;
+    a->y_min = a->y_min - border < 0 ? 0 : a->y_min - border;
+    a->x_max = a->x_max + border >= map_data.width ? map_data.width - 1 : a->x_max + border;
+    a->y_max = a->y_max + border >= map_data.height ? map_data.height - 1 : a->y_max + border;
+    if (a->x_min > a->x_max || a->y_min > a->y_max) {
+        return 0;
+    }
+    if (a->x_min == 0 && a->y_min == 0 && a->x_max == map_data.width - 1 && a->y_max == map_data.height - 1) {
+        return 2;
+    }
+    return 1;
+}
+
+static int rebuild(routing_grid grid, int border, int8_t *items, void (*func)(int y_start, int y_end, void *data),
+    area *a)
+{
+    switch (take_changed_area(grid, border, a)) {
+        case 0:
+            return 0;
+        case 2:
+            map_grid_init_i8(items, -1);
+            break;
+    }
+    thread_pool_run_ranges(func, a->y_max - a->y_min + 1, MIN_ROWS_PER_TASK, a);
+    return 1;
+}
+
 void map_routing_update_all(void)
 {
+    map_routing_mark_all_changed();
     map_routing_update_land();
     map_routing_update_water();
     map_routing_update_walls();
@@ -106,12 +203,13 @@ static int get_land_type_citizen_aqueduct(int grid_offset)
     }
 }
 
-void map_routing_update_land_citizen(void)
+static void update_land_citizen_rows(int start, int end, void *data)
 {
-    map_grid_init_i8(terrain_land_citizen.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+    const area *a = data;
+    for (int y = a->y_min + start; y < a->y_min + end; y++) {
+        rows_with_invalid_buildings[y] = 0;
+        int grid_offset = map_grid_offset(a->x_min, y);
+        for (int x = a->x_min; x <= a->x_max; x++, grid_offset++) {
             int terrain = map_terrain_get(grid_offset);
             if (terrain & TERRAIN_ROAD) {
                 terrain_land_citizen.items[grid_offset] = CITIZEN_0_ROAD;
@@ -119,12 +217,9 @@ void map_routing_update_land_citizen(void)
                 terrain_land_citizen.items[grid_offset] = CITIZEN_2_PASSABLE_TERRAIN;
             } else if (terrain & (TERRAIN_BUILDING | TERRAIN_GATEHOUSE)) {
                 if (!map_building_at(grid_offset)) {
-                    // shouldn't happen
-                    terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
-                    map_terrain_remove(grid_offset, TERRAIN_BUILDING);
-                    map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
-                    map_property_mark_draw_tile(grid_offset);
-                    map_property_set_multi_tile_size(grid_offset, 1);
+                    // shouldn't happen: fixed afterwards, as it changes more than this grid
+                    terrain_land_citizen.items[grid_offset] = -1;
+                    rows_with_invalid_buildings[y] = 1;
                     continue;
                 }
                 terrain_land_citizen.items[grid_offset] = get_land_type_citizen_building(grid_offset);
@@ -139,6 +234,38 @@ void map_routing_update_land_citizen(void)
     }
 }
 
+static void remove_invalid_buildings(const area *a)
+{
+    for (int y = a->y_min; y <= a->y_max; y++) {
+        if (!rows_with_invalid_buildings[y]) {
+            continue;
+        }
+        int grid_offset = map_grid_offset(a->x_min, y);
+        for (int x = a->x_min; x <= a->x_max; x++, grid_offset++) {
+            if (map_terrain_is(grid_offset, TERRAIN_ROAD | TERRAIN_RUBBLE | TERRAIN_ACCESS_RAMP | TERRAIN_GARDEN) ||
+                !map_terrain_is(grid_offset, TERRAIN_BUILDING | TERRAIN_GATEHOUSE) || map_building_at(grid_offset)) {
+                continue;
+            }
+            terrain_land_noncitizen.items[grid_offset] = CITIZEN_4_CLEAR_TERRAIN; // BUG: should be citizen?
+            map_terrain_remove(grid_offset, TERRAIN_BUILDING);
+            map_image_set(grid_offset, (map_random_get(grid_offset) & 7) + image_group(GROUP_TERRAIN_GRASS_1));
+            map_property_mark_draw_tile(grid_offset);
+            map_property_set_multi_tile_size(grid_offset, 1);
+            // a gatehouse tile stays invalid: keep checking it, as a full rebuild would
+            map_routing_mark_tile_changed(grid_offset);
+        }
+    }
+}
+
+void map_routing_update_land_citizen(void)
+{
+    map_road_access_invalidate_roaming();
+    area a;
+    if (rebuild(GRID_LAND_CITIZEN, 0, terrain_land_citizen.items, update_land_citizen_rows, &a)) {
+        remove_invalid_buildings(&a);
+    }
+}
+
 static int get_land_type_noncitizen(int grid_offset)
 {
     int type = NONCITIZEN_1_BUILDING;
@@ -171,12 +298,12 @@ static int get_land_type_noncitizen(int grid_offset)
     return type;
 }
 
-static void map_routing_update_land_noncitizen(void)
+static void update_land_noncitizen_rows(int start, int end, void *data)
 {
-    map_grid_init_i8(terrain_land_noncitizen.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+    const area *a = data;
+    for (int y = a->y_min + start; y < a->y_min + end; y++) {
+        int grid_offset = map_grid_offset(a->x_min, y);
+        for (int x = a->x_min; x <= a->x_max; x++, grid_offset++) {
             int terrain = map_terrain_get(grid_offset);
             if (terrain & TERRAIN_GATEHOUSE) {
                 terrain_land_noncitizen.items[grid_offset] = NONCITIZEN_4_GATEHOUSE;
@@ -199,6 +326,12 @@ static void map_routing_update_land_noncitizen(void)
     }
 }
 
+static void map_routing_update_land_noncitizen(void)
+{
+    area a;
+    rebuild(GRID_LAND_NONCITIZEN, 0, terrain_land_noncitizen.items, update_land_noncitizen_rows, &a);
+}
+
 static int is_surrounded_by_water(int grid_offset)
 {
     return map_terrain_is(grid_offset + map_grid_delta(0, -1), TERRAIN_WATER) &&
@@ -207,12 +340,12 @@ static int is_surrounded_by_water(int grid_offset)
         map_terrain_is(grid_offset + map_grid_delta(0, 1), TERRAIN_WATER);
 }
 
-void map_routing_update_water(void)
+static void update_water_rows(int start, int end, void *data)
 {
-    map_grid_init_i8(terrain_water.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+    const area *a = data;
+    for (int y = a->y_min + start; y < a->y_min + end; y++) {
+        int grid_offset = map_grid_offset(a->x_min, y);
+        for (int x = a->x_min; x <= a->x_max; x++, grid_offset++) {
             if (map_terrain_is(grid_offset, TERRAIN_WATER) && is_surrounded_by_water(grid_offset)) {
                 if (x > 0 && x < map_data.width - 1 &&
                     y > 0 && y < map_data.height - 1) {
@@ -238,6 +371,13 @@ void map_routing_update_water(void)
     }
 }
 
+void map_routing_update_water(void)
+{
+    // water depends on the neighbouring tiles
+    area a;
+    rebuild(GRID_WATER, 1, terrain_water.items, update_water_rows, &a);
+}
+
 static int is_wall_tile(int grid_offset)
 {
     return map_terrain_is(grid_offset, TERRAIN_WALL_OR_GATEHOUSE) ? 1 : 0;
@@ -271,12 +411,12 @@ static int count_adjacent_wall_tiles(int grid_offset)
     return adjacent;
 }
 
-void map_routing_update_walls(void)
+static void update_walls_rows(int start, int end, void *data)
 {
-    map_grid_init_i8(terrain_walls.items, -1);
-    int grid_offset = map_data.start_offset;
-    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
-        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+    const area *a = data;
+    for (int y = a->y_min + start; y < a->y_min + end; y++) {
+        int grid_offset = map_grid_offset(a->x_min, y);
+        for (int x = a->x_min; x <= a->x_max; x++, grid_offset++) {
             if (map_terrain_is(grid_offset, TERRAIN_WALL)) {
                 if (count_adjacent_wall_tiles(grid_offset) == 3) {
                     terrain_walls.items[grid_offset] = WALL_0_PASSABLE;
@@ -292,6 +432,18 @@ void map_routing_update_walls(void)
     }
 }
 
+void map_routing_update_walls(void)
+{
+    if (walls_orientation != city_view_orientation()) {
+        walls_orientation = city_view_orientation();
+        changed[GRID_WALLS].x_min = changed[GRID_WALLS].y_min = 0;
+        changed[GRID_WALLS].x_max = changed[GRID_WALLS].y_max = GRID_SIZE;
+    }
+    // walls depend on the neighbouring tiles
+    area a;
+    rebuild(GRID_WALLS, 1, terrain_walls.items, update_walls_rows, &a);
+}
+
 int map_routing_is_wall_passable(int grid_offset)
 {
     return terrain_walls.items[grid_offset] == WALL_0_PASSABLE;
@@ -7,6 +7,18 @@ void map_routing_update_land_citizen(void);
 void map_routing_update_water(void);
 void map_routing_update_walls(void);
 
+/**
+ * Marks a tile whose terrain, building, aqueduct image or bridge changed.
+ * The routing grids are only rebuilt around marked tiles.
+ * @param grid_offset Tile that changed
+ */
+void map_routing_mark_tile_changed(int grid_offset);
+
+/**
+ * Marks all tiles as changed, for when a whole grid was replaced
+ */
+void map_routing_mark_all_changed(void);
+
 int map_routing_is_wall_passable(int grid_offset);
 int map_routing_wall_tile_in_radius(int x, int y, int radius, int *x_wall, int *y_wall);
 
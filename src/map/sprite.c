@@ -1,9 +1,23 @@
 #include "sprite.h"
 
 #include "map/grid.h"
+#include "map/routing_terrain.h"
 
 static grid_u8 sprite;
 static grid_u8 sprite_backup;
+static grid_journal sprite_journal;
+
+static int set_sprite(int grid_offset, int value)
+{
+    if (sprite.items[grid_offset] == value) {
+        return 0;
+    }
+    if (map_grid_journal_add(&sprite_journal, grid_offset)) {
+        sprite_backup.items[grid_offset] = sprite.items[grid_offset];
+    }
+    sprite.items[grid_offset] = value;
+    return 1;
+}
 
 int map_sprite_animation_at(int grid_offset)
 {
@@ -12,7 +26,7 @@ int map_sprite_animation_at(int grid_offset)
 
 void map_sprite_animation_set(int grid_offset, int value)
 {
-    sprite.items[grid_offset] = value;
+    set_sprite(grid_offset, value);
 }
 
 int map_sprite_bridge_at(int grid_offset)
@@ -22,32 +36,49 @@ int map_sprite_bridge_at(int grid_offset)
 
 void map_sprite_bridge_set(int grid_offset, int value)
 {
-    sprite.items[grid_offset] = value;
+    if (set_sprite(grid_offset, value)) {
+        map_routing_mark_tile_changed(grid_offset);
+    }
 }
 
 void map_sprite_clear_tile(int grid_offset)
 {
-    sprite.items[grid_offset] = 0;
+    if (set_sprite(grid_offset, 0)) {
+        map_routing_mark_tile_changed(grid_offset);
+    }
 }
 
 void map_sprite_clear(void)
 {
-    map_grid_clear_u8(sprite.items);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        set_sprite(i, 0);
+    }
+    map_routing_mark_all_changed();
 }
 
 void map_sprite_backup(void)
 {
-    map_grid_copy_u8(sprite.items, sprite_backup.items);
+    map_grid_journal_clear(&sprite_journal);
 }
 
 void map_sprite_restore(void)
 {
-    map_grid_copy_u8(sprite_backup.items, sprite.items);
+    for (int i = 0; i < sprite_journal.num_tiles; i++) {
+        int grid_offset = sprite_journal.tiles[i];
+        sprite.items[grid_offset] = sprite_backup.items[grid_offset];
+        map_routing_mark_tile_changed(grid_offset);
+    }
 }
 
 void map_sprite_save_state(buffer *buf, buffer *backup)
 {
     map_grid_save_state_u8(sprite.items, buf);
+    // Tiles that did not change since the backup still have their backup value
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        if (!map_grid_journal_contains(&sprite_journal, i)) {
+            sprite_backup.items[i] = sprite.items[i];
+        }
+    }
     map_grid_save_state_u8(sprite_backup.items, backup);
 }
 
@@ -55,4 +86,7 @@ void map_sprite_load_state(buffer *buf, buffer *backup)
 {
     map_grid_load_state_u8(sprite.items, buf);
     map_grid_load_state_u8(sprite_backup.items, backup);
+    map_routing_mark_all_changed();
+    map_grid_journal_clear(&sprite_journal);
+    map_grid_journal_add_all(&sprite_journal);
 }
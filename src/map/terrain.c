@@ -2,10 +2,32 @@
 
 #include "map/grid.h"
 #include "map/ring.h"
+#include "map/road_access.h"
 #include "map/routing.h"
+#include "map/routing_terrain.h"
+#include "map/tile_changes.h"
 
 static grid_u16 terrain_grid;
 static grid_u16 terrain_grid_backup;
+static grid_journal terrain_journal;
+
+static void backup_tile(int grid_offset)
+{
+    if (map_grid_journal_add(&terrain_journal, grid_offset)) {
+        terrain_grid_backup.items[grid_offset] = terrain_grid.items[grid_offset];
+    }
+}
+
+static void set_terrain(int grid_offset, int terrain)
+{
+    if (terrain_grid.items[grid_offset] != terrain) {
+        backup_tile(grid_offset);
+        map_road_access_invalidate_roaming();
+        map_routing_mark_tile_changed(grid_offset);
+        map_tile_changes_mark(grid_offset);
+        terrain_grid.items[grid_offset] = terrain;
+    }
+}
 
 int map_terrain_is(int grid_offset, int terrain)
 {
@@ -19,17 +41,17 @@ int map_terrain_get(int grid_offset)
 
 void map_terrain_set(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] = terrain;
+    set_terrain(grid_offset, terrain);
 }
 
 void map_terrain_add(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] |= terrain;
+    set_terrain(grid_offset, terrain_grid.items[grid_offset] | terrain);
 }
 
 void map_terrain_remove(int grid_offset, int terrain)
 {
-    terrain_grid.items[grid_offset] &= ~terrain;
+    set_terrain(grid_offset, terrain_grid.items[grid_offset] & ~terrain);
 }
 
 void map_terrain_add_with_radius(int x, int y, int size, int radius, int terrain)
@@ -58,7 +80,9 @@ void map_terrain_remove_with_radius(int x, int y, int size, int radius, int terr
 
 void map_terrain_remove_all(int terrain)
 {
-    map_grid_and_u16(terrain_grid.items, ~terrain);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        map_terrain_remove(i, terrain);
+    }
 }
 
 int map_terrain_count_directly_adjacent_with_type(int grid_offset, int terrain)
@@ -319,17 +343,30 @@ void map_terrain_add_triumphal_arch_roads(int x, int y, int orientation)
 
 void map_terrain_backup(void)
 {
-    map_grid_copy_u16(terrain_grid.items, terrain_grid_backup.items);
+    map_grid_journal_clear(&terrain_journal);
 }
 
 void map_terrain_restore(void)
 {
-    map_grid_copy_u16(terrain_grid_backup.items, terrain_grid.items);
+    for (int i = 0; i < terrain_journal.num_tiles; i++) {
+        int grid_offset = terrain_journal.tiles[i];
+        terrain_grid.items[grid_offset] = terrain_grid_backup.items[grid_offset];
+        map_routing_mark_tile_changed(grid_offset);
+        map_tile_changes_mark(grid_offset);
+    }
+    map_road_access_invalidate_roaming();
+}
+
+void map_terrain_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max)
+{
+    map_grid_journal_extend_area(&terrain_journal, x_min, y_min, x_max, y_max);
 }
 
 void map_terrain_clear(void)
 {
-    map_grid_clear_u16(terrain_grid.items);
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        set_terrain(i, 0);
+    }
 }
 
 void map_terrain_init_outside_map(void)
@@ -342,7 +379,7 @@ void map_terrain_init_outside_map(void)
         int y_outside_map = y < y_start || y >= y_start + map_height;
         for (int x = 0; x < GRID_SIZE; x++) {
             if (y_outside_map || x < x_start || x >= x_start + map_width) {
-                terrain_grid.items[x + GRID_SIZE * y] = TERRAIN_TREE | TERRAIN_WATER;
+                set_terrain(x + GRID_SIZE * y, TERRAIN_TREE | TERRAIN_WATER);
             }
         }
     }
@@ -355,5 +392,10 @@ void map_terrain_save_state(buffer *buf)
 
 void map_terrain_load_state(buffer *buf)
 {
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        backup_tile(i);
+    }
     map_grid_load_state_u16(terrain_grid.items, buf);
+    map_road_access_invalidate_roaming();
+    map_routing_mark_all_changed();
 }
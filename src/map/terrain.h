@@ -82,6 +82,8 @@ void map_terrain_backup(void);
 
 void map_terrain_restore(void);
 
+void map_terrain_extend_changed_area(int *x_min, int *y_min, int *x_max, int *y_max);
+
 void map_terrain_clear(void);
 
 void map_terrain_init_outside_map(void);
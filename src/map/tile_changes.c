@@ -0,0 +1,32 @@
+#include "tile_changes.h"
+
+#include "map/grid.h"
+
+static struct {
+    grid_u8 marked;
+    int tiles[GRID_SIZE * GRID_SIZE];
+    int num_tiles;
+} data;
+
+void map_tile_changes_mark(int grid_offset)
+{
+    if (!data.marked.items[grid_offset]) {
+        data.marked.items[grid_offset] = 1;
+        data.tiles[data.num_tiles++] = grid_offset;
+    }
+}
+
+void map_tile_changes_foreach(void (*callback)(int grid_offset))
+{
+    for (int i = 0; i < data.num_tiles; i++) {
+        callback(data.tiles[i]);
+    }
+}
+
+void map_tile_changes_clear(void)
+{
+    for (int i = 0; i < data.num_tiles; i++) {
+        data.marked.items[data.tiles[i]] = 0;
+    }
+    data.num_tiles = 0;
+}
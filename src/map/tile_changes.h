@@ -0,0 +1,27 @@
+#ifndef MAP_TILE_CHANGES_H
+#define MAP_TILE_CHANGES_H
+
+/**
+ * @file
+ * Tiles whose terrain, building or building footprint changed since they were last collected.
+ * Used by views that only redraw changed tiles, such as the minimap.
+ */
+
+/**
+ * Marks a tile as changed
+ * @param grid_offset Tile that changed
+ */
+void map_tile_changes_mark(int grid_offset);
+
+/**
+ * Calls the callback for each tile that changed, in the order they were marked
+ * @param callback Function to call with the grid offset of each changed tile
+ */
+void map_tile_changes_foreach(void (*callback)(int grid_offset));
+
+/**
+ * Forgets all changed tiles
+ */
+void map_tile_changes_clear(void);
+
+#endif // MAP_TILE_CHANGES_H
@@ -939,9 +939,11 @@ void map_tiles_update_all_aqueducts(int include_construction)
     aqueduct_include_construction = 0;
 }
 
-void map_tiles_update_region_aqueducts(int x_min, int y_min, int x_max, int y_max)
+void map_tiles_update_region_aqueducts(int x_min, int y_min, int x_max, int y_max, int include_construction)
 {
+    aqueduct_include_construction = include_construction;
     foreach_region_tile(x_min, y_min, x_max, y_max, update_aqueduct_tile);
+    aqueduct_include_construction = 0;
 }
 
 static void set_earthquake_image(int x, int y, int grid_offset)
@@ -31,7 +31,7 @@ void map_tiles_update_region_water(int x_min, int y_min, int x_max, int y_max);
 void map_tiles_set_water(int x, int y);
 
 void map_tiles_update_all_aqueducts(int include_construction);
-void map_tiles_update_region_aqueducts(int x_min, int y_min, int x_max, int y_max);
+void map_tiles_update_region_aqueducts(int x_min, int y_min, int x_max, int y_max, int include_construction);
 
 void map_tiles_update_all_earthquake(void);
 void map_tiles_set_earthquake(int x, int y);
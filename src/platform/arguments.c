@@ -57,6 +57,7 @@ int platform_parse_arguments(int argc, char **argv, julius_args *output_args)
     output_args->force_windowed = 0;
     output_args->force_fullscreen = 0;
     output_args->display_id = 0;
+    output_args->export_city_images = 0;
 
     for (int i = 1; i < argc; i++) {
         // we ignore "-psn" arguments, this is needed to launch the app
@@ -105,6 +106,8 @@ int platform_parse_arguments(int argc, char **argv, julius_args *output_args)
             output_args->force_windowed = 1;
         } else if (SDL_strcmp(argv[i], "--fullscreen") == 0) {
             output_args->force_fullscreen = 1;
+        } else if (SDL_strcmp(argv[i], "--export-city-images") == 0) {
+            output_args->export_city_images = 1;
         } else if (SDL_strcmp(argv[i], "--help") == 0) {
             ok = 0;
         } else if (SDL_strncmp(argv[i], "--", 2) == 0) {
@@ -132,6 +135,8 @@ int platform_parse_arguments(int argc, char **argv, julius_args *output_args)
         SDL_Log("          Forces the game to start fullscreen");
         SDL_Log("--display ID");
         SDL_Log("          Forces the game to start on the specified display, numbered from 0");
+        SDL_Log("--export-city-images");
+        SDL_Log("          Saves an image of the whole city for each saved game in the data directory, then exits");
         SDL_Log("The last argument, if present, is interpreted as data directory for the Caesar 3 installation");
     }
     return ok;
@@ -1,5 +1,6 @@
 #include "file_manager.h"
 
+#include "core/dir.h"
 #include "core/file.h"
 #include "core/log.h"
 #include "core/string.h"
@@ -209,6 +210,8 @@ int platform_file_manager_set_base_path(const char *path)
         log_error("set_base_path: path was not set. Julius will probably crash.", 0, 0);
         return 0;
     }
+    // Indexed directories are relative to the base path
+    dir_invalidate_index(0);
 #ifdef __ANDROID__
     return android_set_base_path(path);
 #elif defined(_WIN32)
@@ -324,6 +327,36 @@ int platform_file_manager_remove_file(const char *filename)
 
 #endif
 
+int platform_file_manager_get_file_stats(const char *filename, int *size, long long *modified)
+{
+#ifdef _WIN32
+    struct _stat file_info;
+    wchar_t *wfile = utf8_to_wchar(filename);
+    int result = _wstat(wfile, &file_info);
+    free(wfile);
+#elif defined(__ANDROID__)
+    struct stat file_info;
+    int fd = android_get_file_descriptor(filename, "r");
+    if (!fd) {
+        return 0;
+    }
+    int result = fstat(fd, &file_info);
+    close(fd);
+#elif defined(__vita__)
+    struct stat file_info;
+    int result = stat(vita_prepend_path(filename), &file_info);
+#else
+    struct stat file_info;
+    int result = stat(filename, &file_info);
+#endif
+    if (result != 0) {
+        return 0;
+    }
+    *size = (int) file_info.st_size;
+    *modified = (long long) file_info.st_mtime;
+    return 1;
+}
+
 int platform_file_manager_close_file(FILE *stream)
 {
     int result = fclose(stream);
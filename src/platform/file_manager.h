@@ -74,6 +74,15 @@ FILE *platform_file_manager_open_file(const char *filename, const char *mode);
  */
 int platform_file_manager_close_file(FILE *stream);
 
+/**
+ * Gets the size and last modification time of a file
+ * @param filename The file to check
+ * @param size Size of the file in bytes
+ * @param modified Last modification time, only to compare with an earlier one
+ * @return true if the file exists, false otherwise
+ */
+int platform_file_manager_get_file_stats(const char *filename, int *size, long long *modified);
+
 /**
  * Removes a file
  * @param filename The file to remove
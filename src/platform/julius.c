@@ -322,6 +322,14 @@ static void handle_event(SDL_Event *event)
             platform_joystick_device_changed(event->jdevice.which, 0);
             break;
 
+#if SDL_VERSION_ATLEAST(2, 0, 4)
+        case SDL_RENDER_TARGETS_RESET:
+        case SDL_RENDER_DEVICE_RESET:
+            // Texture contents may have been lost: upload the whole canvas again
+            platform_screen_invalidate();
+            break;
+#endif
+
         case SDL_QUIT:
             data.quit = 1;
             break;
@@ -557,6 +565,15 @@ static void setup(const julius_args *args)
         config_set(CONFIG_SCREEN_CURSOR_SCALE, args->cursor_scale_percentage);
     }
 
+    if (args->export_city_images) {
+        // Images are rendered off-screen: no window is needed
+        if (!game_init()) {
+            SDL_Log("Exiting: game init failed");
+            exit_with_status(2);
+        }
+        return;
+    }
+
     char title[100];
     encoding_to_utf8(lang_get_string(9, 0), title, 100, 0);
     if (!platform_screen_create(title, config_get(CONFIG_SCREEN_DISPLAY_SCALE), args->display_id)) {
@@ -588,6 +605,10 @@ int main(int argc, char **argv)
 
     setup(&args);
 
+    if (args.export_city_images) {
+        exit_with_status(game_export_city_images() ? 0 : 1);
+    }
+
     mouse_set_inside_window(1);
     run_and_draw();
 
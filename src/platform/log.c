@@ -1,11 +1,12 @@
 #include "core/log.h"
+#include "core/thread.h"
 #include "SDL.h"
 
 #include <stdio.h>
 
 #define MSG_SIZE 1000
 
-static char log_buffer[MSG_SIZE];
+static THREAD_LOCAL char log_buffer[MSG_SIZE];
 
 static const char *build_message(const char *msg, const char *param_str, int param_int)
 {
@@ -398,12 +398,28 @@ void platform_screen_clear(void)
     SDL_RenderClear(SDL.renderer);
 }
 
+#ifndef __vita__
+static void update_texture_rect(int x, int y, int width, int height)
+{
+    SDL_Rect rect = {x, y, width, height};
+    const color_t *pixels = (const color_t *) graphics_canvas() + y * screen_width() + x;
+    SDL_UpdateTexture(SDL.texture, &rect, pixels, screen_width() * sizeof(color_t));
+}
+#endif
+
+void platform_screen_invalidate(void)
+{
+    graphics_mark_all_dirty();
+}
+
 void platform_screen_update(void)
 {
     SDL_RenderClear(SDL.renderer);
 #ifndef __vita__
-    SDL_UpdateTexture(SDL.texture, NULL, graphics_canvas(), screen_width() * 4);
+    // Only upload the parts of the canvas that were drawn on since the last update
+    graphics_foreach_dirty_rect(update_texture_rect);
 #endif
+    graphics_clear_dirty_rects();
     SDL_RenderCopy(SDL.renderer, SDL.texture, NULL, NULL);
 #ifdef PLATFORM_USE_SOFTWARE_CURSOR
     draw_software_mouse_cursor();
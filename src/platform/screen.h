@@ -22,6 +22,7 @@ void platform_screen_recreate_texture(void);
 #endif
 
 void platform_screen_clear(void);
+void platform_screen_invalidate(void);
 void platform_screen_update(void);
 void platform_screen_render(void);
 
@@ -1,5 +1,6 @@
 #include "core/file.h"
 #include "core/log.h"
+#include "core/thread.h"
 #include "sound/device.h"
 #include "game/settings.h"
 #include "platform/platform.h"
@@ -35,9 +36,20 @@ static struct {
 } vita_music_data;
 #endif
 
+enum {
+    PREFETCH_NONE = 0,
+    PREFETCH_QUEUED = 1,
+    PREFETCH_LOADING = 2,
+    PREFETCH_DONE = 3,
+    PREFETCH_FAILED = 4
+};
+
 typedef struct {
     const char *filename;
     Mix_Chunk *chunk;
+    // Owned by the loader mutex
+    int prefetch;
+    Mix_Chunk *prefetched;
 } sound_channel;
 
 static struct {
@@ -46,6 +58,20 @@ static struct {
     sound_channel channels[MAX_CHANNELS];
 } data;
 
+static struct {
+    thread *worker;
+    thread_mutex *mutex;
+    thread_condition *work_available;
+    thread_condition *work_done;
+    int quit;
+    int started;
+    struct {
+        char filename[FILE_NAME_MAX];
+        Mix_Music *music;
+        int state;
+    } next_music;
+} loader;
+
 static struct {
     SDL_AudioFormat format;
     SDL_AudioFormat dst_format;
@@ -111,9 +137,12 @@ void sound_device_open(void)
     }
 }
 
+static void stop_loader(void);
+
 void sound_device_close(void)
 {
     if (data.initialized) {
+        stop_loader();
         for (int i = 0; i < MAX_CHANNELS; i++) {
             sound_device_stop_channel(i);
         }
@@ -140,14 +169,199 @@ static Mix_Chunk *load_chunk(const char *filename)
     }
 }
 
+static Mix_Music *load_music(const char *filename);
+
+static sound_channel *next_queued_channel(void)
+{
+    for (int i = 0; i < MAX_CHANNELS; i++) {
+        if (data.channels[i].prefetch == PREFETCH_QUEUED) {
+            return &data.channels[i];
+        }
+    }
+    return 0;
+}
+
+static void prefetch_next_chunk(sound_channel *ch)
+{
+    const char *filename = ch->filename;
+    ch->prefetch = PREFETCH_LOADING;
+
+    thread_mutex_unlock(loader.mutex);
+    Mix_Chunk *chunk = load_chunk(filename);
+    thread_mutex_lock(loader.mutex);
+
+    // The channel may have been stopped or reset while loading
+    if (ch->prefetch == PREFETCH_LOADING) {
+        ch->prefetched = chunk;
+        ch->prefetch = PREFETCH_DONE;
+    } else if (chunk) {
+        Mix_FreeChunk(chunk);
+    }
+}
+
+static void prefetch_next_music(void)
+{
+    char filename[FILE_NAME_MAX];
+    strcpy(filename, loader.next_music.filename);
+    loader.next_music.state = PREFETCH_LOADING;
+
+    thread_mutex_unlock(loader.mutex);
+    Mix_Music *music = load_music(filename);
+    thread_mutex_lock(loader.mutex);
+
+    if (loader.next_music.state == PREFETCH_LOADING && strcmp(loader.next_music.filename, filename) == 0) {
+        loader.next_music.music = music;
+        loader.next_music.state = PREFETCH_DONE;
+    } else if (music) {
+        Mix_FreeMusic(music);
+    }
+}
+
+static int loader_loop(void *unused)
+{
+    thread_mutex_lock(loader.mutex);
+    while (!loader.quit) {
+        sound_channel *ch = next_queued_channel();
+        if (ch) {
+            prefetch_next_chunk(ch);
+        } else if (loader.next_music.state == PREFETCH_QUEUED) {
+            prefetch_next_music();
+        } else {
+            thread_condition_wait(loader.work_available, loader.mutex);
+            continue;
+        }
+        thread_condition_broadcast(loader.work_done);
+    }
+    thread_mutex_unlock(loader.mutex);
+    return 0;
+}
+
+static void start_loader(void)
+{
+    if (loader.started) {
+        return;
+    }
+    loader.started = 1;
+    loader.mutex = thread_mutex_create();
+    loader.work_available = thread_condition_create();
+    loader.work_done = thread_condition_create();
+    if (loader.mutex && loader.work_available && loader.work_done) {
+        loader.quit = 0;
+        loader.worker = thread_create(loader_loop, "sound loader", 0);
+        if (loader.worker) {
+            return;
+        }
+    }
+    // Without a background thread, sounds are loaded when they are first played
+    if (loader.work_done) {
+        thread_condition_destroy(loader.work_done);
+        loader.work_done = 0;
+    }
+    if (loader.work_available) {
+        thread_condition_destroy(loader.work_available);
+        loader.work_available = 0;
+    }
+    if (loader.mutex) {
+        thread_mutex_destroy(loader.mutex);
+        loader.mutex = 0;
+    }
+}
+
+static void cancel_prefetch(sound_channel *ch)
+{
+    if (ch->prefetched) {
+        Mix_FreeChunk(ch->prefetched);
+        ch->prefetched = 0;
+    }
+    ch->prefetch = PREFETCH_NONE;
+}
+
+static void stop_loader(void)
+{
+    if (loader.worker) {
+        thread_mutex_lock(loader.mutex);
+        loader.quit = 1;
+        thread_condition_broadcast(loader.work_available);
+        thread_mutex_unlock(loader.mutex);
+        thread_wait(loader.worker);
+        loader.worker = 0;
+        thread_condition_destroy(loader.work_done);
+        thread_condition_destroy(loader.work_available);
+        thread_mutex_destroy(loader.mutex);
+        loader.work_done = 0;
+        loader.work_available = 0;
+        loader.mutex = 0;
+    }
+    loader.started = 0;
+    for (int i = 0; i < MAX_CHANNELS; i++) {
+        cancel_prefetch(&data.channels[i]);
+    }
+    if (loader.next_music.music) {
+        Mix_FreeMusic(loader.next_music.music);
+        loader.next_music.music = 0;
+    }
+    loader.next_music.state = PREFETCH_NONE;
+}
+
+// Must be called with the loader mutex held
+static Mix_Chunk *take_prefetched_chunk(sound_channel *ch)
+{
+    if (ch->prefetch == PREFETCH_QUEUED) {
+        // The caller needs it now: don't load it twice
+        ch->prefetch = PREFETCH_NONE;
+        return 0;
+    }
+    while (ch->prefetch == PREFETCH_LOADING) {
+        thread_condition_wait(loader.work_done, loader.mutex);
+    }
+    if (ch->prefetch != PREFETCH_DONE) {
+        return 0;
+    }
+    Mix_Chunk *chunk = ch->prefetched;
+    ch->prefetched = 0;
+    // Remember failures so missing files are not queued over and over
+    ch->prefetch = chunk ? PREFETCH_NONE : PREFETCH_FAILED;
+    return chunk;
+}
+
 static int load_channel(sound_channel *channel)
 {
     if (!channel->chunk && channel->filename) {
-        channel->chunk = load_chunk(channel->filename);
+        if (loader.worker) {
+            thread_mutex_lock(loader.mutex);
+            channel->chunk = take_prefetched_chunk(channel);
+            thread_mutex_unlock(loader.mutex);
+        }
+        if (!channel->chunk) {
+            channel->chunk = load_chunk(channel->filename);
+        }
     }
     return channel->chunk ? 1 : 0;
 }
 
+void sound_device_prefetch_channel(int channel)
+{
+    if (!data.initialized) {
+        return;
+    }
+    sound_channel *ch = &data.channels[channel];
+    if (ch->chunk || !ch->filename) {
+        return;
+    }
+    start_loader();
+    if (!loader.worker) {
+        return;
+    }
+    thread_mutex_lock(loader.mutex);
+    if (ch->prefetch == PREFETCH_NONE) {
+        ch->prefetch = PREFETCH_QUEUED;
+        thread_condition_signal(loader.work_available);
+    } else if (ch->prefetch == PREFETCH_DONE) {
+        ch->chunk = take_prefetched_chunk(ch);
+    }
+    thread_mutex_unlock(loader.mutex);
+}
+
 void sound_device_init_channels(int num_channels, char filenames[][CHANNEL_FILENAME_MAX])
 {
     if (data.initialized) {
@@ -156,10 +370,17 @@ void sound_device_init_channels(int num_channels, char filenames[][CHANNEL_FILEN
         }
         Mix_AllocateChannels(num_channels);
         log_info("Loading audio files", 0, 0);
+        if (loader.worker) {
+            thread_mutex_lock(loader.mutex);
+        }
         for (int i = 0; i < num_channels; i++) {
+            cancel_prefetch(&data.channels[i]);
             data.channels[i].chunk = 0;
             data.channels[i].filename = filenames[i][0] ? filenames[i] : 0;
         }
+        if (loader.worker) {
+            thread_mutex_unlock(loader.mutex);
+        }
     }
 }
 
@@ -203,6 +424,72 @@ static void load_music_for_vita(const char *filename)
 }
 #endif
 
+static Mix_Music *load_music(const char *filename)
+{
+#ifdef __vita__
+    load_music_for_vita(filename);
+    if (!vita_music_data.buffer) {
+        return 0;
+    }
+    SDL_RWops *sdl_music = SDL_RWFromMem(vita_music_data.buffer, vita_music_data.size);
+    return Mix_LoadMUSType_RW(sdl_music, file_has_extension(filename, "mp3") ? MUS_MP3 : MUS_WAV, SDL_TRUE);
+#elif defined(__ANDROID__)
+    FILE *fp = file_open(filename, "rb");
+    if (!fp) {
+        return 0;
+    }
+    SDL_RWops *sdl_fp = SDL_RWFromFP(fp, SDL_TRUE);
+    return Mix_LoadMUSType_RW(sdl_fp, file_has_extension(filename, "mp3") ? MUS_MP3 : MUS_WAV, SDL_TRUE);
+#else
+    return Mix_LoadMUS(filename);
+#endif
+}
+
+static Mix_Music *take_prefetched_music(const char *filename)
+{
+    if (!loader.worker) {
+        return 0;
+    }
+    Mix_Music *music = 0;
+    thread_mutex_lock(loader.mutex);
+    if (loader.next_music.state != PREFETCH_NONE && strcmp(loader.next_music.filename, filename) == 0) {
+        while (loader.next_music.state == PREFETCH_LOADING) {
+            thread_condition_wait(loader.work_done, loader.mutex);
+        }
+        music = loader.next_music.music;
+        loader.next_music.music = 0;
+        loader.next_music.state = PREFETCH_NONE;
+    }
+    thread_mutex_unlock(loader.mutex);
+    return music;
+}
+
+void sound_device_prefetch_music(const char *filename)
+{
+#ifndef __vita__
+    // Vita keeps the music file in a single shared buffer, so it can only be loaded when played
+    if (!data.initialized || !filename) {
+        return;
+    }
+    start_loader();
+    if (!loader.worker) {
+        return;
+    }
+    thread_mutex_lock(loader.mutex);
+    if (loader.next_music.state == PREFETCH_NONE || strcmp(loader.next_music.filename, filename) != 0) {
+        if (loader.next_music.music) {
+            Mix_FreeMusic(loader.next_music.music);
+            loader.next_music.music = 0;
+        }
+        strncpy(loader.next_music.filename, filename, FILE_NAME_MAX - 1);
+        loader.next_music.filename[FILE_NAME_MAX - 1] = 0;
+        loader.next_music.state = PREFETCH_QUEUED;
+        thread_condition_signal(loader.work_available);
+    }
+    thread_mutex_unlock(loader.mutex);
+#endif
+}
+
 int sound_device_play_music(const char *filename, int volume_pct)
 {
     if (data.initialized) {
@@ -210,23 +497,10 @@ int sound_device_play_music(const char *filename, int volume_pct)
         if (!filename) {
             return 0;
         }
-#ifdef __vita__
-        load_music_for_vita(filename);
-        if (!vita_music_data.buffer) {
-            return 0;
-        }
-        SDL_RWops *sdl_music = SDL_RWFromMem(vita_music_data.buffer, vita_music_data.size);
-        data.music = Mix_LoadMUSType_RW(sdl_music, file_has_extension(filename, "mp3") ? MUS_MP3 : MUS_WAV, SDL_TRUE);
-#elif defined(__ANDROID__)
-        FILE *fp = file_open(filename, "rb");
-        if (!fp) {
-            return 0;
+        data.music = take_prefetched_music(filename);
+        if (!data.music) {
+            data.music = load_music(filename);
         }
-        SDL_RWops *sdl_fp = SDL_RWFromFP(fp, SDL_TRUE);
-        data.music = Mix_LoadMUSType_RW(sdl_fp, file_has_extension(filename, "mp3") ? MUS_MP3 : MUS_WAV, SDL_TRUE);
-#else
-        data.music = Mix_LoadMUS(filename);
-#endif
         if (!data.music) {
             SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                 "Error opening music file '%s'. Reason: %s", filename, Mix_GetError());
@@ -299,6 +573,11 @@ void sound_device_stop_channel(int channel)
             Mix_FreeChunk(ch->chunk);
             ch->chunk = 0;
         }
+        if (loader.worker) {
+            thread_mutex_lock(loader.mutex);
+            cancel_prefetch(ch);
+            thread_mutex_unlock(loader.mutex);
+        }
     }
 }
 
@@ -0,0 +1,68 @@
+#include "core/thread.h"
+
+#include "SDL.h"
+
+int thread_cpu_count(void)
+{
+    int count = SDL_GetCPUCount();
+    return count > 0 ? count : 1;
+}
+
+thread *thread_create(int (*func)(void *), const char *name, void *data)
+{
+    SDL_Thread *t = SDL_CreateThread(func, name, data);
+    if (!t) {
+        SDL_Log("Unable to create thread %s: %s", name, SDL_GetError());
+    }
+    return (thread *) t;
+}
+
+void thread_wait(thread *t)
+{
+    SDL_WaitThread((SDL_Thread *) t, 0);
+}
+
+thread_mutex *thread_mutex_create(void)
+{
+    return (thread_mutex *) SDL_CreateMutex();
+}
+
+void thread_mutex_destroy(thread_mutex *mutex)
+{
+    SDL_DestroyMutex((SDL_mutex *) mutex);
+}
+
+void thread_mutex_lock(thread_mutex *mutex)
+{
+    SDL_LockMutex((SDL_mutex *) mutex);
+}
+
+void thread_mutex_unlock(thread_mutex *mutex)
+{
+    SDL_UnlockMutex((SDL_mutex *) mutex);
+}
+
+thread_condition *thread_condition_create(void)
+{
+    return (thread_condition *) SDL_CreateCond();
+}
+
+void thread_condition_destroy(thread_condition *condition)
+{
+    SDL_DestroyCond((SDL_cond *) condition);
+}
+
+void thread_condition_wait(thread_condition *condition, thread_mutex *mutex)
+{
+    SDL_CondWait((SDL_cond *) condition, (SDL_mutex *) mutex);
+}
+
+void thread_condition_signal(thread_condition *condition)
+{
+    SDL_CondSignal((SDL_cond *) condition);
+}
+
+void thread_condition_broadcast(thread_condition *condition)
+{
+    SDL_CondBroadcast((SDL_cond *) condition);
+}
@@ -0,0 +1,13 @@
+#include "core/time.h"
+
+#include "SDL.h"
+
+uint64_t time_get_micros(void)
+{
+    static Uint64 frequency;
+    if (!frequency) {
+        frequency = SDL_GetPerformanceFrequency();
+    }
+    Uint64 counter = SDL_GetPerformanceCounter();
+    return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+}
@@ -0,0 +1,11 @@
+// DO NOT EDIT. This file is generated by CMake.
+// Run CMake configure step to update it.
+#include "game/system.h"
+
+#define JULIUS_VERSION "1.7.0"
+#define JULIUS_VERSION_SUFFIX "-20261018-d73524f-dirty"
+
+const char *system_version(void)
+{
+    return JULIUS_VERSION JULIUS_VERSION_SUFFIX;
+}
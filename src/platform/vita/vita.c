@@ -1,6 +1,7 @@
 #include "vita.h"
 
 #include "core/file.h"
+#include "core/thread.h"
 #include "game/system.h"
 #include "graphics/screen.h"
 #include "input/mouse.h"
@@ -15,7 +16,8 @@
 
 #define PREPEND_PATH_OFFSET 17
 
-static char prepended_path[2 * FILE_NAME_MAX * sizeof(char)];
+// Thread-local, since files may be opened from background threads
+static THREAD_LOCAL char prepended_path[2 * FILE_NAME_MAX * sizeof(char)];
 
 // max heap size is approx. 330 MB with -d ATTRIBUTE2=12, otherwise max is 192
 int _newlib_heap_size_user = 330 * 1024 * 1024;
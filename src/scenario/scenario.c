@@ -437,6 +437,15 @@ void scenario_load_state(buffer *buf)
     scenario.is_saved = 1;
 }
 
+void scenario_read_climate_and_enemy(buffer *buf, int *climate, int *enemy)
+{
+    // start year, empire, requests and invasions, initial funds
+    buffer_set(buf, 380);
+    *enemy = buffer_read_i16(buf);
+    buffer_set(buf, 1704);
+    *climate = buffer_read_u8(buf);
+}
+
 void scenario_settings_init(void)
 {
     scenario.settings.campaign_mission = 0;
@@ -13,6 +13,14 @@ void scenario_save_state(buffer *buf);
 
 void scenario_load_state(buffer *buf);
 
+/**
+ * Reads the climate and enemy from a saved scenario piece, without loading it
+ * @param buf Scenario piece
+ * @param climate Climate of the scenario
+ * @param enemy Enemy of the scenario
+ */
+void scenario_read_climate_and_enemy(buffer *buf, int *climate, int *enemy);
+
 void scenario_settings_save_state(
     buffer *part1, buffer *part2, buffer *part3, buffer *player_name, buffer *scenario_name);
 
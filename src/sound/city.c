@@ -268,6 +268,10 @@ void sound_city_play(void)
         channels[i].should_play = 0;
         if (channels[i].available) {
             channels[i].available = 0;
+            if (setting_sound(SOUND_CITY)->enabled) {
+                // Buildings in view need many views before their sound plays, so it can load meanwhile
+                sound_device_prefetch_channel(channels[i].channel + CITY_CHANNEL_OFFSET);
+            }
             if (channels[i].total_views >= channels[i].views_threshold) {
                 if (now - channels[i].last_played_time >= channels[i].delay_millis) {
                     channels[i].should_play = 1;
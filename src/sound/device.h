@@ -19,6 +19,20 @@ void sound_device_play_channel_panned(int channel, int volume_pct, int left_pct,
 void sound_device_stop_music(void);
 void sound_device_stop_channel(int channel);
 
+/**
+ * Loads the sound of a channel in the background, so playing it later doesn't block.
+ * Without a background thread, the sound is loaded when it is first played.
+ * @param channel Channel to load
+ */
+void sound_device_prefetch_channel(int channel);
+
+/**
+ * Opens a music file in the background, so a later call to sound_device_play_music
+ * with the same filename can start it right away. Only the most recent file is kept.
+ * @param filename Music file to open
+ */
+void sound_device_prefetch_music(const char *filename);
+
 /**
  * Use a custom music player, for external music data (e.g. videos)
  * @param bitdepth Bitdepth, either 8 or 16
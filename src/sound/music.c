@@ -1,6 +1,7 @@
 #include "music.h"
 
 #include "core/dir.h"
+#include "core/file.h"
 #include "city/figures.h"
 #include "city/population.h"
 #include "game/settings.h"
@@ -53,21 +54,52 @@ void sound_music_set_volume(int percentage)
     sound_device_set_music_volume(percentage);
 }
 
+static const char *track_filename(int track)
+{
+    const char *mp3_track = dir_get_file(mp3_tracks[track], NOT_LOCALIZED);
+    return mp3_track ? mp3_track : dir_get_file(tracks[track], NOT_LOCALIZED);
+}
+
 static void play_track(int track)
 {
     sound_device_stop_music();
     if (track <= TRACK_NONE || track >= TRACK_MAX) {
         return;
     }
-    const char *mp3_track = dir_get_file(mp3_tracks[track], NOT_LOCALIZED);
+    const char *filename = track_filename(track);
 
     int volume = setting_sound(SOUND_MUSIC)->volume;
-    if (!mp3_track || !sound_device_play_music(mp3_track, volume)) {
+    if (!sound_device_play_music(filename, volume) && filename && file_has_extension(filename, "mp3")) {
+        // the mp3 could not be played: fall back to the original wav
         sound_device_play_music(dir_get_file(tracks[track], NOT_LOCALIZED), volume);
     }
     data.current_track = track;
 }
 
+static int city_track(int population)
+{
+    if (population < 1000) {
+        return TRACK_CITY_1;
+    } else if (population < 2000) {
+        return TRACK_CITY_2;
+    } else if (population < 5000) {
+        return TRACK_CITY_3;
+    } else if (population < 7000) {
+        return TRACK_CITY_4;
+    } else {
+        return TRACK_CITY_5;
+    }
+}
+
+static void prefetch_next_track(int track, int population)
+{
+    // After combat the city track returns, otherwise the city grows into the next one
+    int next_track = track == TRACK_COMBAT_SHORT || track == TRACK_COMBAT_LONG ? city_track(population) : track + 1;
+    if (next_track >= TRACK_CITY_1 && next_track <= TRACK_CITY_5 && setting_sound(SOUND_MUSIC)->enabled) {
+        sound_device_prefetch_music(track_filename(next_track));
+    }
+}
+
 void sound_music_play_intro(void)
 {
     if (setting_sound(SOUND_MUSIC)->enabled) {
@@ -98,16 +130,8 @@ void sound_music_update(int force)
         track = TRACK_COMBAT_LONG;
     } else if (total_enemies > 0) {
         track = TRACK_COMBAT_SHORT;
-    } else if (population < 1000) {
-        track = TRACK_CITY_1;
-    } else if (population < 2000) {
-        track = TRACK_CITY_2;
-    } else if (population < 5000) {
-        track = TRACK_CITY_3;
-    } else if (population < 7000) {
-        track = TRACK_CITY_4;
     } else {
-        track = TRACK_CITY_5;
+        track = city_track(population);
     }
 
     if (track == data.current_track) {
@@ -115,6 +139,7 @@ void sound_music_update(int force)
     }
 
     play_track(track);
+    prefetch_next_track(track, population);
     data.next_check = 10;
 }
 
@@ -5,8 +5,12 @@
 #include "city/finance.h"
 #include "city/view.h"
 #include "city/warning.h"
+#include "core/config.h"
 #include "core/direction.h"
+#include "core/log.h"
 #include "core/string.h"
+#include "core/thread.h"
+#include "core/thread_pool.h"
 #include "figure/formation_legion.h"
 #include "game/settings.h"
 #include "game/state.h"
@@ -30,6 +34,13 @@
 #include "window/building_info.h"
 #include "window/city.h"
 
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_FOOTPRINT_BAND_HEIGHT 60
+// Footprints of 5x5 buildings extend 60 pixels above and 90 pixels below their draw tile
+#define FOOTPRINT_BAND_MARGIN 120
+
 static struct {
     map_tile current_tile;
     map_tile selected_tile;
@@ -37,6 +48,139 @@ static struct {
     int capture_input;
 } data;
 
+static struct {
+    map_callback *prepare;
+    map_callback *draw;
+    int x;
+    int y;
+    int width;
+    int height;
+    int band_height;
+    struct {
+        color_t *expected;
+        color_t *actual;
+        int size;
+        int mismatch_reported;
+    } verify;
+} footprints;
+
+static void prepare_and_draw_footprint(int x, int y, int grid_offset)
+{
+    footprints.prepare(x, y, grid_offset);
+    footprints.draw(x, y, grid_offset);
+}
+
+static void draw_footprint_band(int index, void *unused)
+{
+    int band_y = footprints.y + index * footprints.band_height;
+    int band_end = band_y + footprints.band_height;
+    if (band_end > footprints.y + footprints.height) {
+        band_end = footprints.y + footprints.height;
+    }
+    // The band is already marked as dirty by the main thread
+    graphics_set_damage_tracking(0);
+    graphics_set_clip_rectangle(footprints.x, band_y, footprints.width, band_end - band_y);
+    city_view_foreach_map_tile_in_pixel_rows(footprints.draw,
+        band_y - FOOTPRINT_BAND_MARGIN, band_end + FOOTPRINT_BAND_MARGIN);
+    graphics_set_damage_tracking(1);
+}
+
+static void draw_footprints_banded(void)
+{
+    int num_bands = 2 * thread_pool_num_threads();
+    footprints.band_height = (footprints.height + num_bands - 1) / num_bands;
+    if (footprints.band_height < MIN_FOOTPRINT_BAND_HEIGHT) {
+        footprints.band_height = MIN_FOOTPRINT_BAND_HEIGHT;
+    }
+    num_bands = (footprints.height + footprints.band_height - 1) / footprints.band_height;
+    graphics_mark_dirty(footprints.x, footprints.y, footprints.width, footprints.height);
+    thread_pool_run(draw_footprint_band, num_bands, 0);
+    // The calling thread drew bands as well: restore its clip rectangle
+    graphics_set_clip_rectangle(footprints.x, footprints.y, footprints.width, footprints.height);
+}
+
+static int allocate_verify_buffers(void)
+{
+    int size = footprints.width * footprints.height;
+    if (size <= footprints.verify.size) {
+        return 1;
+    }
+    free(footprints.verify.expected);
+    free(footprints.verify.actual);
+    footprints.verify.expected = malloc(sizeof(color_t) * size);
+    footprints.verify.actual = malloc(sizeof(color_t) * size);
+    if (!footprints.verify.expected || !footprints.verify.actual) {
+        free(footprints.verify.expected);
+        free(footprints.verify.actual);
+        footprints.verify.expected = 0;
+        footprints.verify.actual = 0;
+        footprints.verify.size = 0;
+        return 0;
+    }
+    footprints.verify.size = size;
+    return 1;
+}
+
+static void verify_footprints_banded(void)
+{
+    if (!allocate_verify_buffers()) {
+        draw_footprints_banded();
+        return;
+    }
+    graphics_fill_rect(footprints.x, footprints.y, footprints.width, footprints.height, COLOR_BLACK);
+    city_view_foreach_map_tile(footprints.draw);
+    graphics_save_to_buffer(footprints.x, footprints.y, footprints.width, footprints.height,
+        footprints.verify.expected);
+
+    graphics_fill_rect(footprints.x, footprints.y, footprints.width, footprints.height, COLOR_BLACK);
+    draw_footprints_banded();
+    graphics_save_to_buffer(footprints.x, footprints.y, footprints.width, footprints.height,
+        footprints.verify.actual);
+
+    for (int y = 0; y < footprints.height; y++) {
+        int offset = y * footprints.width;
+        if (memcmp(&footprints.verify.expected[offset], &footprints.verify.actual[offset],
+                sizeof(color_t) * footprints.width) != 0) {
+            if (!footprints.verify.mismatch_reported) {
+                log_error("Threaded drawing differs from single-threaded drawing at row", 0, footprints.y + y);
+                footprints.verify.mismatch_reported = 1;
+            }
+            return;
+        }
+    }
+    footprints.verify.mismatch_reported = 0;
+}
+
+static int use_threaded_drawing(void)
+{
+#ifdef THREAD_NO_LOCAL_STORAGE
+    return 0;
+#else
+    return config_get(CONFIG_SCREEN_THREADED_DRAWING) && thread_pool_num_threads() > 1;
+#endif
+}
+
+void widget_city_draw_footprints(map_callback *prepare, map_callback *draw)
+{
+    footprints.prepare = prepare;
+    footprints.draw = draw;
+    if (!use_threaded_drawing()) {
+        city_view_foreach_map_tile(prepare_and_draw_footprint);
+        return;
+    }
+    // Everything with side effects runs once, on this thread, before the bands are drawn
+    city_view_foreach_map_tile(prepare);
+    graphics_get_clip_rectangle(&footprints.x, &footprints.y, &footprints.width, &footprints.height);
+    if (footprints.width <= 0 || footprints.height <= 0) {
+        return;
+    }
+    if (config_get(CONFIG_SCREEN_VERIFY_THREADED_DRAWING)) {
+        verify_footprints_banded();
+    } else {
+        draw_footprints_banded();
+    }
+}
+
 static void set_city_clip_rectangle(void)
 {
     int x, y, width, height;
@@ -1,6 +1,7 @@
 #ifndef WIDGET_CITY_H
 #define WIDGET_CITY_H
 
+#include "city/view.h"
 #include "graphics/tooltip.h"
 #include "input/hotkey.h"
 #include "input/mouse.h"
@@ -13,6 +14,15 @@ typedef struct {
 void widget_city_draw(void);
 void widget_city_draw_for_figure(int figure_id, pixel_coordinate *coord);
 
+/**
+ * Draws the footprints of all tiles in the current clip rectangle.
+ * When threaded drawing is enabled, the footprints are drawn in horizontal bands
+ * on the thread pool: the draw callback must then not change any state.
+ * @param prepare Callback for the non-drawing work of a tile, always called on the calling thread
+ * @param draw Callback that draws the footprint of a tile
+ */
+void widget_city_draw_footprints(map_callback *prepare, map_callback *draw);
+
 void widget_city_draw_construction_cost_and_size(void);
 void widget_city_draw_touch_buttons(void);
 
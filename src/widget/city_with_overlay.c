@@ -289,9 +289,13 @@ void city_with_overlay_draw_building_footprint(int x, int y, int grid_offset, in
     }
 }
 
-static void draw_footprint(int x, int y, int grid_offset)
+static void prepare_footprint(int x, int y, int grid_offset)
 {
     building_construction_record_view_position(x, y, grid_offset);
+}
+
+static void draw_footprint(int x, int y, int grid_offset)
+{
     if (grid_offset < 0) {
         // Outside map: draw black tile
         image_draw_isometric_footprint_from_draw_tile(image_group(GROUP_TERRAIN_BLACK), x, y, 0);
@@ -545,7 +549,7 @@ void city_with_overlay_draw(const map_tile *tile)
     }
 
     int should_mark_deleting = city_building_ghost_mark_deleting(tile);
-    city_view_foreach_map_tile(draw_footprint);
+    widget_city_draw_footprints(prepare_footprint, draw_footprint);
     if (!should_mark_deleting) {
         city_view_foreach_valid_map_tile_row(
             draw_figures,
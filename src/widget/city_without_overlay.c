@@ -23,6 +23,7 @@
 #include "map/sprite.h"
 #include "map/terrain.h"
 #include "sound/city.h"
+#include "widget/city.h"
 #include "widget/city_bridge.h"
 #include "widget/city_building_ghost.h"
 #include "widget/city_figure.h"
@@ -97,9 +98,45 @@ static int has_adjacent_deletion(int grid_offset)
     return 0;
 }
 
-static void draw_footprint(int x, int y, int grid_offset)
+static void prepare_footprint(int x, int y, int grid_offset)
 {
     building_construction_record_view_position(x, y, grid_offset);
+    if (grid_offset < 0 || !map_property_is_draw_tile(grid_offset)) {
+        return;
+    }
+    int building_id = map_building_at(grid_offset);
+    if (building_id) {
+        building *b = building_get(building_id);
+        int view_x, view_y, view_width, view_height;
+        city_view_get_viewport(&view_x, &view_y, &view_width, &view_height);
+        if (x < view_x + 100) {
+            sound_city_mark_building_view(b, SOUND_DIRECTION_LEFT);
+        } else if (x > view_x + view_width - 100) {
+            sound_city_mark_building_view(b, SOUND_DIRECTION_RIGHT);
+        } else {
+            sound_city_mark_building_view(b, SOUND_DIRECTION_CENTER);
+        }
+    }
+    if (map_terrain_is(grid_offset, TERRAIN_GARDEN)) {
+        building *b = building_get(0); // abuse empty building
+        b->type = BUILDING_GARDENS;
+        sound_city_mark_building_view(b, SOUND_DIRECTION_CENTER);
+    }
+    int image_id = map_image_at(grid_offset);
+    if (draw_context.advance_water_animation &&
+        !map_property_is_constructing(grid_offset) &&
+        image_id >= draw_context.image_id_water_first &&
+        image_id <= draw_context.image_id_water_last) {
+        image_id++;
+        if (image_id > draw_context.image_id_water_last) {
+            image_id = draw_context.image_id_water_first;
+        }
+        map_image_set_animation_frame(grid_offset, image_id);
+    }
+}
+
+static void draw_footprint(int x, int y, int grid_offset)
+{
     if (grid_offset < 0) {
         // Outside map: draw black tile
         image_draw_isometric_footprint_from_draw_tile(image_group(GROUP_TERRAIN_BLACK), x, y, 0);
@@ -107,39 +144,13 @@ static void draw_footprint(int x, int y, int grid_offset)
         // Valid grid_offset and leftmost tile -> draw
         int building_id = map_building_at(grid_offset);
         color_t color_mask = 0;
-        if (building_id) {
-            building *b = building_get(building_id);
-            if (draw_building_as_deleted(b)) {
-                color_mask = COLOR_MASK_RED;
-            }
-            int view_x, view_y, view_width, view_height;
-            city_view_get_viewport(&view_x, &view_y, &view_width, &view_height);
-            if (x < view_x + 100) {
-                sound_city_mark_building_view(b, SOUND_DIRECTION_LEFT);
-            } else if (x > view_x + view_width - 100) {
-                sound_city_mark_building_view(b, SOUND_DIRECTION_RIGHT);
-            } else {
-                sound_city_mark_building_view(b, SOUND_DIRECTION_CENTER);
-            }
-        }
-        if (map_terrain_is(grid_offset, TERRAIN_GARDEN)) {
-            building *b = building_get(0); // abuse empty building
-            b->type = BUILDING_GARDENS;
-            sound_city_mark_building_view(b, SOUND_DIRECTION_CENTER);
+        if (building_id && draw_building_as_deleted(building_get(building_id))) {
+            color_mask = COLOR_MASK_RED;
         }
         int image_id = map_image_at(grid_offset);
         if (map_property_is_constructing(grid_offset)) {
             image_id = image_group(GROUP_TERRAIN_OVERLAY);
         }
-        if (draw_context.advance_water_animation &&
-            image_id >= draw_context.image_id_water_first &&
-            image_id <= draw_context.image_id_water_last) {
-            image_id++;
-            if (image_id > draw_context.image_id_water_last) {
-                image_id = draw_context.image_id_water_first;
-            }
-            map_image_set(grid_offset, image_id);
-        }
         image_draw_isometric_footprint_from_draw_tile(image_id, x, y, color_mask);
     }
 }
@@ -519,7 +530,7 @@ void city_without_overlay_draw(int selected_figure_id, pixel_coordinate *figure_
     }
     init_draw_context(selected_figure_id, figure_coord, highlighted_formation);
     int should_mark_deleting = city_building_ghost_mark_deleting(tile);
-    city_view_foreach_map_tile(draw_footprint);
+    widget_city_draw_footprints(prepare_footprint, draw_footprint);
     if (!should_mark_deleting) {
         city_view_foreach_valid_map_tile_row(
             draw_top,
@@ -59,7 +59,7 @@ static void draw_footprint(int x, int y, int grid_offset)
             if (image_id > draw_context.image_id_water_last) {
                 image_id = draw_context.image_id_water_first;
             }
-            map_image_set(grid_offset, image_id);
+            map_image_set_animation_frame(grid_offset, image_id);
         }
         image_draw_isometric_footprint_from_draw_tile(image_id, x, y, color_mask);
     }
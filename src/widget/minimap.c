@@ -12,9 +12,14 @@
 #include "map/property.h"
 #include "map/random.h"
 #include "map/terrain.h"
+#include "map/tile_changes.h"
 #include "scenario/property.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+// Multi-tile building images extend up to 4 rows above their draw tile
+#define TILE_IMAGE_ROW_MARGIN 5
 
 enum {
     FIGURE_COLOR_NONE = 0,
@@ -27,7 +32,8 @@ enum {
 enum {
     REFRESH_NOT_NEEDED = 0,
     REFRESH_FULL = 1,
-    REFRESH_CAMERA_MOVED = 2
+    REFRESH_CAMERA_MOVED = 2,
+    REFRESH_TILES = 3
 };
 
 static const color_t ENEMY_COLOR_BY_CLIMATE[] = {
@@ -47,12 +53,19 @@ static struct {
     int height;
     color_t enemy_color;
     color_t *cache;
+    uint8_t *dirty_rows;
+    int tile_key[GRID_SIZE * GRID_SIZE];
+    struct {
+        int y_min;
+        int y_max;
+    } band;
     struct {
         int x;
         int y;
         int grid_offset;
     } mouse;
     int refresh_requested;
+    int update_requested;
     int camera_x;
     int camera_y;
 } data;
@@ -62,6 +75,11 @@ void widget_minimap_invalidate(void)
     data.refresh_requested = 1;
 }
 
+void widget_minimap_update(void)
+{
+    data.update_requested = 1;
+}
+
 static void foreach_map_tile(map_callback *callback)
 {
     city_view_foreach_minimap_tile(data.x_offset, data.y_offset,
@@ -70,6 +88,16 @@ static void foreach_map_tile(map_callback *callback)
                                    callback);
 }
 
+static void foreach_map_tile_in_rows(map_callback *callback, int y_min, int y_max)
+{
+    // start on an even row to keep the alternating row offsets, the callback also gets 4 rows around
+    int first_row = y_min & ~1;
+    city_view_foreach_minimap_tile(data.x_offset, data.y_offset + first_row,
+                                   data.absolute_x, data.absolute_y + first_row,
+                                   data.width_tiles, y_max - first_row,
+                                   callback);
+}
+
 static void set_bounds(int x_offset, int y_offset, int width, int height)
 {
     data.width_tiles = width / 2;
@@ -123,11 +151,11 @@ static int has_figure_color(figure *f)
     return FIGURE_COLOR_NONE;
 }
 
-static int draw_figure(int x_view, int y_view, int grid_offset)
+static void draw_figure(int x_view, int y_view, int grid_offset)
 {
     int color_type = map_figure_foreach_until(grid_offset, has_figure_color);
     if (color_type == FIGURE_COLOR_NONE) {
-        return 0;
+        return;
     }
     color_t color = COLOR_MINIMAP_WOLF;
     if (color_type == FIGURE_COLOR_SOLDIER) {
@@ -138,20 +166,11 @@ static int draw_figure(int x_view, int y_view, int grid_offset)
         color = data.enemy_color;
     }
     graphics_draw_horizontal_line(x_view, x_view + 1, y_view, color);
-    return 1;
 }
 
-static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
+static int get_tile_image(int grid_offset, int *size)
 {
-    if (grid_offset < 0) {
-        image_draw(image_group(GROUP_MINIMAP_BLACK), x_view, y_view);
-        return;
-    }
-
-    if (draw_figure(x_view, y_view, grid_offset)) {
-        return;
-    }
-
+    *size = 1;
     int terrain = map_terrain_get(grid_offset);
     // exception for fort ground: display as empty land
     if (terrain & TERRAIN_BUILDING) {
@@ -161,45 +180,101 @@ static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
     }
 
     if (terrain & TERRAIN_BUILDING) {
-        if (map_property_is_draw_tile(grid_offset)) {
-            int image_id;
-            building *b = building_get(map_building_at(grid_offset));
-            if (b->house_size) {
-                image_id = image_group(GROUP_MINIMAP_HOUSE);
-            } else if (b->type == BUILDING_RESERVOIR) {
-                image_id = image_group(GROUP_MINIMAP_AQUEDUCT) - 1;
-            } else {
-                image_id = image_group(GROUP_MINIMAP_BUILDING);
-            }
-            switch (map_property_multi_tile_size(grid_offset)) {
-                case 1: image_draw(image_id, x_view, y_view); break;
-                case 2: image_draw(image_id + 1, x_view, y_view - 1); break;
-                case 3: image_draw(image_id + 2, x_view, y_view - 2); break;
-                case 4: image_draw(image_id + 3, x_view, y_view - 3); break;
-                case 5: image_draw(image_id + 4, x_view, y_view - 4); break;
-            }
+        if (!map_property_is_draw_tile(grid_offset)) {
+            return 0;
         }
-    } else {
-        int rand = map_random_get(grid_offset);
         int image_id;
-        if (terrain & TERRAIN_ROAD) {
-            image_id = image_group(GROUP_MINIMAP_ROAD);
-        } else if (terrain & TERRAIN_WATER) {
-            image_id = image_group(GROUP_MINIMAP_WATER) + (rand & 3);
-        } else if (terrain & (TERRAIN_SHRUB | TERRAIN_TREE)) {
-            image_id = image_group(GROUP_MINIMAP_TREE) + (rand & 3);
-        } else if (terrain & (TERRAIN_ROCK | TERRAIN_ELEVATION)) {
-            image_id = image_group(GROUP_MINIMAP_ROCK) + (rand & 3);
-        } else if (terrain & TERRAIN_AQUEDUCT) {
-            image_id = image_group(GROUP_MINIMAP_AQUEDUCT);
-        } else if (terrain & TERRAIN_WALL) {
-            image_id = image_group(GROUP_MINIMAP_WALL);
-        } else if (terrain & TERRAIN_MEADOW) {
-            image_id = image_group(GROUP_MINIMAP_MEADOW) + (rand & 3);
+        building *b = building_get(map_building_at(grid_offset));
+        if (b->house_size) {
+            image_id = image_group(GROUP_MINIMAP_HOUSE);
+        } else if (b->type == BUILDING_RESERVOIR) {
+            image_id = image_group(GROUP_MINIMAP_AQUEDUCT) - 1;
         } else {
-            image_id = image_group(GROUP_MINIMAP_EMPTY_LAND) + (rand & 7);
+            image_id = image_group(GROUP_MINIMAP_BUILDING);
+        }
+        *size = map_property_multi_tile_size(grid_offset);
+        if (*size < 1 || *size > 5) {
+            return 0;
         }
-        image_draw(image_id, x_view, y_view);
+        return image_id + *size - 1;
+    }
+    int rand = map_random_get(grid_offset);
+    if (terrain & TERRAIN_ROAD) {
+        return image_group(GROUP_MINIMAP_ROAD);
+    } else if (terrain & TERRAIN_WATER) {
+        return image_group(GROUP_MINIMAP_WATER) + (rand & 3);
+    } else if (terrain & (TERRAIN_SHRUB | TERRAIN_TREE)) {
+        return image_group(GROUP_MINIMAP_TREE) + (rand & 3);
+    } else if (terrain & (TERRAIN_ROCK | TERRAIN_ELEVATION)) {
+        return image_group(GROUP_MINIMAP_ROCK) + (rand & 3);
+    } else if (terrain & TERRAIN_AQUEDUCT) {
+        return image_group(GROUP_MINIMAP_AQUEDUCT);
+    } else if (terrain & TERRAIN_WALL) {
+        return image_group(GROUP_MINIMAP_WALL);
+    } else if (terrain & TERRAIN_MEADOW) {
+        return image_group(GROUP_MINIMAP_MEADOW) + (rand & 3);
+    } else {
+        return image_group(GROUP_MINIMAP_EMPTY_LAND) + (rand & 7);
+    }
+}
+
+static int get_tile_key(int image_id, int size)
+{
+    return image_id * 8 + size;
+}
+
+static void draw_minimap_tile(int x_view, int y_view, int grid_offset)
+{
+    if (grid_offset < 0) {
+        image_draw(image_group(GROUP_MINIMAP_BLACK), x_view, y_view);
+        return;
+    }
+    int size;
+    int image_id = get_tile_image(grid_offset, &size);
+    data.tile_key[grid_offset] = get_tile_key(image_id, size);
+    if (image_id) {
+        image_draw(image_id, x_view, y_view - size + 1);
+    }
+}
+
+static void draw_figure_dot(int x_view, int y_view, int grid_offset)
+{
+    if (grid_offset >= 0 && map_has_figure_at(grid_offset)) {
+        draw_figure(x_view, y_view, grid_offset);
+    }
+}
+
+static void mark_rows_dirty(int y_min, int y_max)
+{
+    if (y_min < 0) {
+        y_min = 0;
+    }
+    if (y_max > data.height) {
+        y_max = data.height;
+    }
+    for (int y = y_min; y < y_max; y++) {
+        data.dirty_rows[y] = 1;
+    }
+}
+
+static void check_tile_changed(int grid_offset)
+{
+    int size;
+    int image_id = get_tile_image(grid_offset, &size);
+    if (data.tile_key[grid_offset] == get_tile_key(image_id, size)) {
+        return;
+    }
+    int x_view, y_view;
+    if (city_view_grid_offset_to_xy_view(grid_offset, &x_view, &y_view)) {
+        int y = y_view - data.absolute_y;
+        mark_rows_dirty(y - TILE_IMAGE_ROW_MARGIN, y + TILE_IMAGE_ROW_MARGIN + 1);
+    }
+}
+
+static void draw_minimap_tile_in_band(int x_view, int y_view, int grid_offset)
+{
+    if (y_view >= data.band.y_min && y_view < data.band.y_max) {
+        draw_minimap_tile(x_view, y_view, grid_offset);
     }
 }
 
@@ -230,7 +305,9 @@ static void prepare_minimap_cache(int width, int height)
 {
     if (width != data.width || height != data.height) {
         free(data.cache);
+        free(data.dirty_rows);
         data.cache = (color_t *)malloc(sizeof(color_t) * width * height);
+        data.dirty_rows = (uint8_t *)malloc(sizeof(uint8_t) * height);
     }
 }
 
@@ -239,12 +316,52 @@ static void cache_minimap(void)
     graphics_save_to_buffer(data.x_offset, data.y_offset, data.width, data.height, data.cache);
 }
 
+static void redraw_dirty_rows(int y_start, int y_end)
+{
+    int height = y_end - y_start;
+    graphics_set_clip_rectangle(data.x_offset, data.y_offset + y_start, data.width, height);
+    graphics_fill_rect(data.x_offset, data.y_offset + y_start, data.width, height, COLOR_BLACK);
+    data.band.y_min = data.y_offset + y_start - TILE_IMAGE_ROW_MARGIN;
+    data.band.y_max = data.y_offset + y_end + TILE_IMAGE_ROW_MARGIN;
+    foreach_map_tile_in_rows(draw_minimap_tile_in_band, y_start - TILE_IMAGE_ROW_MARGIN, y_end + TILE_IMAGE_ROW_MARGIN);
+    graphics_save_to_buffer(data.x_offset, data.y_offset + y_start, data.width, height,
+        &data.cache[y_start * data.width]);
+}
+
+static void update_changed_tiles(void)
+{
+    memset(data.dirty_rows, 0, sizeof(uint8_t) * data.height);
+    // terrain and building setters record which tiles changed since the last update
+    map_tile_changes_foreach(check_tile_changed);
+    map_tile_changes_clear();
+    int y = 0;
+    while (y < data.height) {
+        if (!data.dirty_rows[y]) {
+            y++;
+            continue;
+        }
+        int y_start = y;
+        while (y < data.height && data.dirty_rows[y]) {
+            y++;
+        }
+        redraw_dirty_rows(y_start, y);
+    }
+    graphics_set_clip_rectangle(data.x_offset, data.y_offset, data.width, data.height);
+}
+
+static void draw_overlays(void)
+{
+    foreach_map_tile(draw_figure_dot);
+    draw_viewport_rectangle();
+}
+
 static void draw_minimap(void)
 {
     graphics_set_clip_rectangle(data.x_offset, data.y_offset, data.width, data.height);
+    map_tile_changes_clear();
     foreach_map_tile(draw_minimap_tile);
     cache_minimap();
-    draw_viewport_rectangle();
+    draw_overlays();
     graphics_reset_clip_rectangle();
 }
 
@@ -256,7 +373,7 @@ static void draw_uncached(int x_offset, int y_offset, int width, int height)
     draw_minimap();
 }
 
-static void draw_using_cache(int x_offset, int y_offset, int width, int height)
+static void draw_using_cache(int x_offset, int y_offset, int width, int height, int update_tiles)
 {
     if (width != data.width || height != data.height || x_offset != data.x_offset) {
         draw_uncached(x_offset, y_offset, width, height);
@@ -273,16 +390,24 @@ static void draw_using_cache(int x_offset, int y_offset, int width, int height)
 
     graphics_set_clip_rectangle(x_offset, y_offset, width, height);
     graphics_draw_from_buffer(x_offset, y_offset, data.width, data.height, data.cache);
-    draw_viewport_rectangle();
+    if (update_tiles) {
+        update_changed_tiles();
+    }
+    draw_overlays();
     graphics_reset_clip_rectangle();
 }
 
 static int should_refresh(int force)
 {
-    if (data.refresh_requested || force) {
+    if (data.refresh_requested) {
         data.refresh_requested = 0;
+        data.update_requested = 0;
         return REFRESH_FULL;
     }
+    if (data.update_requested || force) {
+        data.update_requested = 0;
+        return REFRESH_TILES;
+    }
     int new_x, new_y;
     city_view_get_camera(&new_x, &new_y);
     if (data.camera_x != new_x || data.camera_y != new_y) {
@@ -298,7 +423,7 @@ void widget_minimap_draw(int x_offset, int y_offset, int width, int height, int
         if (refresh_type == REFRESH_FULL) {
             draw_uncached(x_offset, y_offset, width, height);
         } else {
-            draw_using_cache(x_offset, y_offset, width, height);
+            draw_using_cache(x_offset, y_offset, width, height, refresh_type == REFRESH_TILES);
         }
         graphics_draw_horizontal_line(x_offset - 1, x_offset - 1 + width, y_offset - 1, COLOR_MINIMAP_DARK);
         graphics_draw_vertical_line(x_offset - 1, y_offset, y_offset + height, COLOR_MINIMAP_DARK);
@@ -5,6 +5,11 @@
 
 void widget_minimap_invalidate(void);
 
+/**
+ * Requests the minimap to recolour the tiles that changed and to redraw the figures
+ */
+void widget_minimap_update(void);
+
 void widget_minimap_draw(int x_offset, int y_offset, int width, int height, int force);
 
 int widget_minimap_handle_mouse(const mouse *m);
@@ -10,6 +10,7 @@
 #include "core/time.h"
 #include "game/file.h"
 #include "game/file_editor.h"
+#include "game/saved_game_index.h"
 #include "graphics/generic_button.h"
 #include "graphics/graphics.h"
 #include "graphics/image.h"
@@ -81,6 +82,29 @@ static input_box file_name_input = {144, 80, 20, 2, FONT_NORMAL_WHITE, 0, data.t
 static file_type_data saved_game_data = {"sav"};
 static file_type_data scenario_data = {"map"};
 
+static int lists_native_saved_games(void)
+{
+    // native saved games can be loaded and deleted, but the dialog saves in the classic format
+    return data.type == FILE_TYPE_SAVED_GAME && data.dialog_type != FILE_DIALOG_SAVE;
+}
+
+static const dir_listing *find_files(void)
+{
+    if (lists_native_saved_games()) {
+        const char *extensions[] = {data.file_data->extension, NATIVE_SAVED_GAME_EXTENSION};
+        return dir_find_files_with_extensions(extensions, 2);
+    }
+    return dir_find_files_with_extension(data.file_data->extension);
+}
+
+static void remove_default_extension(uint8_t *filename)
+{
+    // other extensions stay visible, so native saved games can be told apart
+    if (file_has_extension((const char *) filename, data.file_data->extension)) {
+        file_remove_extension(filename);
+    }
+}
+
 static int find_first_file_with_prefix(const char *prefix)
 {
     int len = (int) strlen(prefix);
@@ -131,7 +155,11 @@ static void init(file_type type, file_dialog_type dialog_type)
 
     if (strlen(data.file_data->last_loaded_file) > 0) {
         encoding_from_utf8(data.file_data->last_loaded_file, data.typed_name, FILE_NAME_MAX);
-        file_remove_extension(data.typed_name);
+        if (dialog_type == FILE_DIALOG_SAVE) {
+            file_remove_extension(data.typed_name);
+        } else {
+            remove_default_extension(data.typed_name);
+        }
     } else if (dialog_type == FILE_DIALOG_SAVE) {
         // Suggest default filename
         string_copy(lang_get_string(9, type == FILE_TYPE_SCENARIO ? 7 : 6), data.typed_name, FILE_NAME_MAX);
@@ -141,7 +169,10 @@ static void init(file_type type, file_dialog_type dialog_type)
     }
     string_copy(data.typed_name, data.previously_seen_typed_name, FILE_NAME_MAX);
 
-    data.file_list = dir_find_files_with_extension(data.file_data->extension);
+    data.file_list = find_files();
+    if (type == FILE_TYPE_SAVED_GAME) {
+        saved_game_index_update(data.file_list);
+    }
     scrollbar_init(&scrollbar, 0, data.file_list->num_files - NUM_FILES_IN_VIEW);
     scroll_to_typed_text();
 
@@ -149,6 +180,33 @@ static void init(file_type type, file_dialog_type dialog_type)
     input_box_start(&file_name_input);
 }
 
+static const char *get_details_filename(void)
+{
+    int index = scrollbar.scroll_position + data.focus_button_id - 1;
+    if (data.focus_button_id > 0 && index < data.file_list->num_files) {
+        return data.file_list->files[index];
+    }
+    return data.selected_file[0] ? data.selected_file : 0;
+}
+
+static void draw_saved_game_details(void)
+{
+    const char *filename = get_details_filename();
+    saved_game_info info;
+    if (!filename || !saved_game_index_get(filename, &info)) {
+        return;
+    }
+    outer_panel_draw(128, 384, 24, 4);
+    text_draw_ellipsized(info.scenario_name, 144, 398, 224, FONT_NORMAL_BLACK, 0);
+    lang_text_draw_month_year_max_width(info.month, info.year, 368, 398, 96, FONT_NORMAL_BLACK, 0);
+
+    text_draw_ellipsized(info.player_name, 144, 420, 144, FONT_NORMAL_BLACK, 0);
+    int width = lang_text_draw(6, 0, 296, 420, FONT_NORMAL_BLACK);
+    text_draw_number(info.treasury, '@', " ", 292 + width, 420, FONT_NORMAL_BLACK);
+    width = lang_text_draw(6, 1, 384, 420, FONT_NORMAL_BLACK);
+    text_draw_number(info.population, '@', " ", 380 + width, 420, FONT_NORMAL_BLACK);
+}
+
 static void draw_foreground(void)
 {
     graphics_in_dialog();
@@ -176,7 +234,7 @@ static void draw_foreground(void)
             font = FONT_NORMAL_WHITE;
         }
         encoding_from_utf8(data.file_list->files[scrollbar.scroll_position + i], file, FILE_NAME_MAX);
-        file_remove_extension(file);
+        remove_default_extension(file);
         text_ellipsize(file, font, MAX_FILE_WINDOW_TEXT_WIDTH);
         text_draw(file, 160, 130 + 16 * i, font, 0);
     }
@@ -184,6 +242,10 @@ static void draw_foreground(void)
     image_buttons_draw(0, 0, image_buttons, 2);
     scrollbar_draw(&scrollbar);
 
+    if (data.type == FILE_TYPE_SAVED_GAME) {
+        draw_saved_game_details();
+    }
+
     graphics_reset_dialog();
 }
 
@@ -232,7 +294,7 @@ static const char *get_chosen_filename(void)
     // Check if we should work with the selected file
     uint8_t selected_name[FILE_NAME_MAX];
     encoding_from_utf8(data.selected_file, selected_name, FILE_NAME_MAX);
-    file_remove_extension(selected_name);
+    remove_default_extension(selected_name);
 
     if (string_equals(selected_name, data.typed_name)) {
         // User has not modified the string after selecting it: use filename
@@ -242,7 +304,9 @@ static const char *get_chosen_filename(void)
     // We should use the typed name, which needs to be converted to UTF-8...
     static char typed_file[FILE_NAME_MAX];
     encoding_to_utf8(data.typed_name, typed_file, FILE_NAME_MAX, encoding_system_uses_decomposed());
-    file_append_extension(typed_file, data.file_data->extension);
+    if (!lists_native_saved_games() || !file_has_extension(typed_file, NATIVE_SAVED_GAME_EXTENSION)) {
+        file_append_extension(typed_file, data.file_data->extension);
+    }
     return typed_file;
 }
 
@@ -289,7 +353,8 @@ static void button_ok_cancel(int is_ok, int param2)
         }
     } else if (data.dialog_type == FILE_DIALOG_DELETE) {
         if (game_file_delete_saved_game(filename)) {
-            dir_find_files_with_extension(data.file_data->extension);
+            find_files();
+            saved_game_index_update(data.file_list);
             if (scrollbar.scroll_position + NUM_FILES_IN_VIEW >= data.file_list->num_files) {
                 --scrollbar.scroll_position;
             }
@@ -312,7 +377,7 @@ static void button_select_file(int index, int param2)
     if (index < data.file_list->num_files) {
         strncpy(data.selected_file, data.file_list->files[scrollbar.scroll_position + index], FILE_NAME_MAX - 1);
         encoding_from_utf8(data.selected_file, data.typed_name, FILE_NAME_MAX);
-        file_remove_extension(data.typed_name);
+        remove_default_extension(data.typed_name);
         string_copy(data.typed_name, data.previously_seen_typed_name, FILE_NAME_MAX);
         input_box_refresh_text(&file_name_input);
         data.message_not_exist_start_time = 0;
@@ -0,0 +1,88 @@
+#include "core/time.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "game/settings.h"
+#include "map/data.h"
+#include "map/grid.h"
+#include "map/road_access.h"
+#include "map/terrain.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_ITERATIONS 200
+#define DEFAULT_TICKS 500
+
+static double seconds_since(clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void bench_roaming_decisions(int iterations)
+{
+    static int road_offsets[GRID_SIZE * GRID_SIZE];
+    int num_roads = 0;
+    int grid_offset = map_data.start_offset;
+    for (int y = 0; y < map_data.height; y++, grid_offset += map_data.border_size) {
+        for (int x = 0; x < map_data.width; x++, grid_offset++) {
+            if (map_terrain_is(grid_offset, TERRAIN_ROAD)) {
+                road_offsets[num_roads++] = grid_offset;
+            }
+        }
+    }
+    if (!num_roads) {
+        printf("No roads on this map\n");
+        return;
+    }
+    int checksum = 0;
+    clock_t start = clock();
+    for (int i = 0; i < iterations; i++) {
+        for (int r = 0; r < num_roads; r++) {
+            int road_tiles[8];
+            int adjacent = map_get_adjacent_road_tiles_for_roaming(road_offsets[r], road_tiles);
+            if (adjacent >= 3) {
+                adjacent += map_get_diagonal_road_tiles_for_roaming(road_offsets[r], road_tiles);
+            }
+            checksum += adjacent;
+        }
+    }
+    double seconds = seconds_since(start);
+    double steps = (double) iterations * num_roads;
+    printf("Roaming decisions: %.0f on %d road tiles in %.3f s: %.0f steps/s (checksum %d)\n",
+        steps, num_roads, seconds, seconds > 0 ? steps / seconds : 0, checksum);
+}
+
+static void bench_ticks(int ticks)
+{
+    setting_reset_speeds(500, setting_scroll_speed());
+    time_set_millis(0);
+    clock_t start = clock();
+    for (int i = 1; i <= ticks; i++) {
+        time_set_millis(2 * i);
+        game_run();
+    }
+    double seconds = seconds_since(start);
+    printf("Game ticks: %d in %.3f s: %.0f ticks/s\n", ticks, seconds, seconds > 0 ? ticks / seconds : 0);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("Usage: roamingbench SAVED_GAME [ITERATIONS] [TICKS]\n");
+        return -1;
+    }
+    int iterations = argc > 2 ? atoi(argv[2]) : DEFAULT_ITERATIONS;
+    int ticks = argc > 3 ? atoi(argv[3]) : DEFAULT_TICKS;
+    if (!game_pre_init() || !game_init()) {
+        printf("Unable to initialize the game\n");
+        return 1;
+    }
+    if (!game_file_load_saved_game(argv[1])) {
+        printf("Unable to load saved game %s\n", argv[1]);
+        return 2;
+    }
+    bench_roaming_decisions(iterations);
+    bench_ticks(ticks);
+    return 0;
+}
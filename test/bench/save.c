@@ -0,0 +1,116 @@
+#include "core/buffer.h"
+#include "game/file.h"
+#include "game/file_io.h"
+#include "game/game.h"
+#include "map/grid.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_ITERATIONS 50
+#define GRID_ITERATIONS 2000
+#define UNCOMPRESSED_SAVED_GAME "savebench.sav"
+
+static grid_u16 grid;
+static uint8_t grid_data[GRID_SIZE * GRID_SIZE * 2];
+
+static double seconds_since(clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void print_speed(const char *name, double bytes, double seconds)
+{
+    printf("%s: %.3f s, %.0f MB/s\n", name, seconds, seconds > 0 ? bytes / seconds / 1000000 : 0);
+}
+
+static void bench_grid(void)
+{
+    for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+        grid.items[i] = (uint16_t) (i * 7919);
+    }
+    double bytes = (double) GRID_ITERATIONS * sizeof(grid_data);
+    buffer buf;
+    buffer_init(&buf, grid_data, sizeof(grid_data));
+
+    clock_t start = clock();
+    for (int n = 0; n < GRID_ITERATIONS; n++) {
+        buffer_reset(&buf);
+        for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            buffer_write_u16(&buf, grid.items[i]);
+        }
+    }
+    print_speed("Grid save, per value", bytes, seconds_since(start));
+
+    start = clock();
+    for (int n = 0; n < GRID_ITERATIONS; n++) {
+        buffer_reset(&buf);
+        map_grid_save_state_u16(grid.items, &buf);
+    }
+    print_speed("Grid save, array", bytes, seconds_since(start));
+
+    start = clock();
+    for (int n = 0; n < GRID_ITERATIONS; n++) {
+        buffer_reset(&buf);
+        for (int i = 0; i < GRID_SIZE * GRID_SIZE; i++) {
+            grid.items[i] = buffer_read_u16(&buf);
+        }
+    }
+    print_speed("Grid load, per value", bytes, seconds_since(start));
+
+    start = clock();
+    for (int n = 0; n < GRID_ITERATIONS; n++) {
+        buffer_reset(&buf);
+        map_grid_load_state_u16(grid.items, &buf);
+    }
+    print_speed("Grid load, array", bytes, seconds_since(start));
+}
+
+static int bench_saved_game(int iterations)
+{
+    // Without compression, the time is spent converting the game state
+    clock_t start = clock();
+    for (int i = 0; i < iterations; i++) {
+        if (!game_file_io_write_saved_game_format(UNCOMPRESSED_SAVED_GAME, SAVEGAME_FORMAT_NATIVE_UNCOMPRESSED)) {
+            printf("Unable to write %s\n", UNCOMPRESSED_SAVED_GAME);
+            return 0;
+        }
+    }
+    double seconds = seconds_since(start);
+    printf("Save: %d in %.3f s, %.2f ms each\n", iterations, seconds, 1000 * seconds / iterations);
+
+    start = clock();
+    for (int i = 0; i < iterations; i++) {
+        if (!game_file_io_read_saved_game(UNCOMPRESSED_SAVED_GAME, 0)) {
+            printf("Unable to read %s\n", UNCOMPRESSED_SAVED_GAME);
+            return 0;
+        }
+    }
+    seconds = seconds_since(start);
+    printf("Load: %d in %.3f s, %.2f ms each\n", iterations, seconds, 1000 * seconds / iterations);
+    remove(UNCOMPRESSED_SAVED_GAME);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("Usage: savebench SAVED_GAME [ITERATIONS]\n");
+        return -1;
+    }
+    int iterations = argc > 2 ? atoi(argv[2]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        iterations = DEFAULT_ITERATIONS;
+    }
+    if (!game_pre_init() || !game_init()) {
+        printf("Unable to initialize the game\n");
+        return 1;
+    }
+    if (!game_file_load_saved_game(argv[1])) {
+        printf("Unable to load saved game %s\n", argv[1]);
+        return 2;
+    }
+    bench_grid();
+    return bench_saved_game(iterations) ? 0 : 3;
+}
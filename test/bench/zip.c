@@ -0,0 +1,95 @@
+#include "core/zip.h"
+#include "sav/sav_compare.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_ITERATIONS 5
+#define BUFFER_SIZE 600000
+
+static const struct {
+    zip_compression_level level;
+    const char *name;
+} levels[] = {
+    {ZIP_COMPRESSION_ORIGINAL, "original"},
+    {ZIP_COMPRESSION_FAST, "fast"},
+    {ZIP_COMPRESSION_DEFAULT, "default"},
+    {ZIP_COMPRESSION_MAX, "max"},
+};
+
+#define NUM_LEVELS (sizeof(levels) / sizeof(levels[0]))
+
+static struct {
+    int iterations;
+    int errors;
+    double input_bytes;
+    double output_bytes[NUM_LEVELS];
+    double seconds[NUM_LEVELS];
+    double decode_seconds[NUM_LEVELS];
+} data;
+
+static unsigned char compressed[BUFFER_SIZE];
+static unsigned char decompressed[BUFFER_SIZE];
+
+static double seconds_since(clock_t start)
+{
+    return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+static void bench_part(const char *name, const unsigned char *input, int length)
+{
+    data.input_bytes += (double) length * data.iterations;
+    for (int l = 0; l < NUM_LEVELS; l++) {
+        int compressed_length = 0;
+        clock_t start = clock();
+        for (int i = 0; i < data.iterations; i++) {
+            compressed_length = BUFFER_SIZE;
+            if (!zip_compress_level(input, length, compressed, &compressed_length, levels[l].level)) {
+                printf("Unable to compress %s at level %s\n", name, levels[l].name);
+                data.errors++;
+                return;
+            }
+        }
+        data.seconds[l] += seconds_since(start);
+        data.output_bytes[l] += (double) compressed_length * data.iterations;
+
+        int decompressed_length = 0;
+        int ok = 1;
+        start = clock();
+        for (int i = 0; i < data.iterations && ok; i++) {
+            decompressed_length = length;
+            ok = zip_decompress(compressed, compressed_length, decompressed, &decompressed_length);
+        }
+        data.decode_seconds[l] += seconds_since(start);
+        if (!ok || decompressed_length != length || memcmp(input, decompressed, length) != 0) {
+            printf("Round trip failed for %s at level %s\n", name, levels[l].name);
+            data.errors++;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        printf("Usage: zipbench SAVED_GAME... [-i ITERATIONS]\n");
+        return -1;
+    }
+    data.iterations = DEFAULT_ITERATIONS;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            data.iterations = atoi(argv[++i]);
+        } else if (!for_each_compressed_part(argv[i], bench_part)) {
+            return 2;
+        }
+    }
+    for (int l = 0; l < NUM_LEVELS; l++) {
+        double megabytes = data.input_bytes / (1024 * 1024);
+        printf("Level %-8s: ratio %.4f, %.1f MB, compress %.3f s: %.1f MB/s, decompress %.3f s: %.1f MB/s\n",
+            levels[l].name, data.input_bytes > 0 ? data.output_bytes[l] / data.input_bytes : 0, megabytes,
+            data.seconds[l], data.seconds[l] > 0 ? megabytes / data.seconds[l] : 0,
+            data.decode_seconds[l], data.decode_seconds[l] > 0 ? megabytes / data.decode_seconds[l] : 0);
+    }
+    return data.errors ? 1 : 0;
+}
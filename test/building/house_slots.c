@@ -0,0 +1,67 @@
+#include "building/building.h"
+#include "building/house_evolution.h"
+#include "game/file.h"
+#include "game/game.h"
+#include "map/building.h"
+
+#include <stdio.h>
+
+static building *find_non_house(void)
+{
+    for (int i = 1; i < MAX_BUILDINGS; i++) {
+        building *b = building_get(i);
+        if (b->state == BUILDING_STATE_IN_USE && b->size == 1 && !building_may_be_house(i)) {
+            return b;
+        }
+    }
+    return 0;
+}
+
+static int test_vacant_lot_in_reused_slot(void)
+{
+    building *old = find_non_house();
+    if (!old) {
+        printf("No building to replace\n");
+        return 0;
+    }
+    int x = old->x;
+    int y = old->y;
+    old->state = BUILDING_STATE_UNUSED;
+
+    // Placed mid-day: the periodic sweep that rebuilds the house slots does not run before the evolve pass
+    building *lot = building_create(BUILDING_HOUSE_VACANT_LOT, x, y);
+    if (!lot->id) {
+        printf("Unable to create a vacant lot\n");
+        return 0;
+    }
+    map_building_set(lot->grid_offset, lot->id);
+    lot->state = BUILDING_STATE_IN_USE;
+    lot->data.house.no_space_to_expand = 1;
+
+    building_house_process_evolve_and_consume_goods();
+
+    if (lot->data.house.no_space_to_expand) {
+        printf("Vacant lot %d was not visited by the evolve pass\n", lot->id);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        printf("Usage: houseslots SAVED_GAME\n");
+        return -1;
+    }
+    if (!game_pre_init() || !game_init()) {
+        printf("Unable to initialize the game\n");
+        return 1;
+    }
+    if (!game_file_load_saved_game(argv[1])) {
+        printf("Unable to load saved game %s\n", argv[1]);
+        return 2;
+    }
+    int ok = test_vacant_lot_in_reused_slot();
+    game_exit();
+    return ok ? 0 : 3;
+}
@@ -1,8 +1,12 @@
+#include "city/finance.h"
+#include "city/population.h"
 #include "core/backtrace.h"
 #include "core/time.h"
 #include "game/file.h"
+#include "game/file_io.h"
 #include "game/game.h"
 #include "game/settings.h"
+#include "game/time.h"
 
 #ifdef _MSC_VER
 #include <direct.h>
@@ -15,6 +19,7 @@
 #include <signal.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "sav_compare.h"
 
 static void handler(int sig)
@@ -34,7 +39,41 @@ static void run_ticks(int ticks)
     }
 }
 
-static int run_autopilot(const char *input_saved_game, const char *output_saved_game, int ticks_to_run)
+static int round_trip(const char *output_saved_game, const char *format_name)
+{
+    savegame_format format;
+    if (strcmp(format_name, "native") == 0) {
+        format = SAVEGAME_FORMAT_NATIVE;
+    } else if (strcmp(format_name, "native-uncompressed") == 0) {
+        format = SAVEGAME_FORMAT_NATIVE_UNCOMPRESSED;
+    } else {
+        printf("Unknown save format %s\n", format_name);
+        return 0;
+    }
+    char filename[500];
+    snprintf(filename, sizeof(filename), "%s.%s", output_saved_game, format_name);
+    printf("Round trip through %s\n", filename);
+    // Save twice: the second native save reuses the chunks of the first one
+    if (!game_file_io_write_saved_game_format(filename, format) ||
+        !game_file_io_write_saved_game_format(filename, format) ||
+        !game_file_io_read_saved_game(filename, 0)) {
+        return 0;
+    }
+    saved_game_info info;
+    if (!game_file_io_read_saved_game_info(filename, &info)) {
+        printf("Unable to read the summary of %s\n", filename);
+        return 0;
+    }
+    if (info.treasury != city_finance_treasury() || info.population != city_population() ||
+        info.month != game_time_month() || info.year != game_time_year()) {
+        printf("Summary of %s does not match the game\n", filename);
+        return 0;
+    }
+    return 1;
+}
+
+static int run_autopilot(const char *input_saved_game, const char *output_saved_game, int ticks_to_run,
+    const char *round_trip_format)
 {
     printf("Running autopilot: %s --> %s in %d ticks\n", input_saved_game, output_saved_game, ticks_to_run);
     signal(SIGSEGV, handler);
@@ -59,6 +98,10 @@ static int run_autopilot(const char *input_saved_game, const char *output_saved_
         return 3;
     }
     run_ticks(ticks_to_run);
+    if (round_trip_format && !round_trip(output_saved_game, round_trip_format)) {
+        printf("Unable to save and load the game in %s format\n", round_trip_format);
+        return 4;
+    }
     printf("Saving game to %s\n", output_saved_game);
     game_file_write_saved_game(output_saved_game);
     printf("Done\n");
@@ -70,7 +113,7 @@ static int run_autopilot(const char *input_saved_game, const char *output_saved_
 
 int main(int argc, char **argv)
 {
-    if (argc != 5) {
+    if (argc != 5 && argc != 6) {
         printf("Incorrect number of arguments (%d)\n", argc);
         return -1;
     }
@@ -78,7 +121,8 @@ int main(int argc, char **argv)
     const char *output = argv[2];
     const char *expected = argv[3];
     int ticks = atoi(argv[4]);
-    if (run_autopilot(input, output, ticks) == 0) {
+    const char *round_trip_format = argc > 5 ? argv[5] : 0;
+    if (run_autopilot(input, output, ticks, round_trip_format) == 0) {
         return compare_files(expected, output);
     } else {
         return 1;
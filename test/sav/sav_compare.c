@@ -322,6 +322,22 @@ static int unpack(const char *filename, unsigned char *buffer)
     return offset;
 }
 
+int for_each_compressed_part(const char *filename,
+    void (*callback)(const char *name, const unsigned char *data, int length))
+{
+    if (!unpack(filename, file1_data)) {
+        return 0;
+    }
+    int offset = 0;
+    for (int i = 0; save_game_parts[i].length_in_bytes; i++) {
+        if (save_game_parts[i].compressed) {
+            callback(save_game_parts[i].name, &file1_data[offset], save_game_parts[i].length_in_bytes);
+        }
+        offset += save_game_parts[i].length_in_bytes;
+    }
+    return 1;
+}
+
 static int has_adjacent_terrain_type(int part_offset, int terrain_type)
 {
     int grid_offset = part_offset / 2;
@@ -3,4 +3,7 @@
 
 int compare_files(const char *file1, const char *file2);
 
+int for_each_compressed_part(const char *filename,
+    void (*callback)(const char *name, const unsigned char *data, int length));
+
 #endif // SAV_COMPARE_H
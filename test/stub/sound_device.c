@@ -39,3 +39,9 @@ void sound_device_stop_music(void)
 
 void sound_device_stop_channel(int channel)
 {}
+
+void sound_device_prefetch_channel(int channel)
+{}
+
+void sound_device_prefetch_music(const char *filename)
+{}
@@ -0,0 +1,45 @@
+#include "core/thread.h"
+
+int thread_cpu_count(void)
+{
+    return 1;
+}
+
+thread *thread_create(int (*func)(void *), const char *name, void *data)
+{
+    return 0;
+}
+
+void thread_wait(thread *t)
+{}
+
+thread_mutex *thread_mutex_create(void)
+{
+    return 0;
+}
+
+void thread_mutex_destroy(thread_mutex *mutex)
+{}
+
+void thread_mutex_lock(thread_mutex *mutex)
+{}
+
+void thread_mutex_unlock(thread_mutex *mutex)
+{}
+
+thread_condition *thread_condition_create(void)
+{
+    return 0;
+}
+
+void thread_condition_destroy(thread_condition *condition)
+{}
+
+void thread_condition_wait(thread_condition *condition, thread_mutex *mutex)
+{}
+
+void thread_condition_signal(thread_condition *condition)
+{}
+
+void thread_condition_broadcast(thread_condition *condition)
+{}
@@ -0,0 +1,8 @@
+#include "core/time.h"
+
+#include <time.h>
+
+uint64_t time_get_micros(void)
+{
+    return (uint64_t) clock() * 1000000 / CLOCKS_PER_SEC;
+}
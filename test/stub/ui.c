@@ -1,3 +1,4 @@
+#include "graphics/screenshot.h"
 #include "graphics/window.h"
 #include "widget/minimap.h"
 #include "window/building_info.h"
@@ -60,9 +61,17 @@ void window_message_dialog_show_city_message(int text_id, int year, int month,
 void window_popup_dialog_show(popup_dialog_type type, void (*okFunc)(int), int hasOkCancelButtons)
 {}
 
+int graphics_save_full_city_screenshot(const char *filename)
+{
+    return 0;
+}
+
 void widget_minimap_invalidate(void)
 {}
 
+void widget_minimap_update(void)
+{}
+
 int window_building_info_get_building_type(void)
 {
     return 0;